@@ -11,3 +11,31 @@
 #include "dualcomplex_conversion.h"
 #include "dualcomplex_relational.h"
 #include "dualcomplex_query.h"
+#include "dualcomplex_jacobian.h"
+#include "dualcomplex_posegraph.h"
+#include "dualcomplex_icp.h"
+#include "dualcomplex_estimation.h"
+#include "dualcomplex_parallel.h"
+#include "dualcomplex_ransac.h"
+#include "dualcomplex_soa.h"
+#include "dualcomplex_batch_query.h"
+#include "dualcomplex_pose_index.h"
+#include "dualcomplex_canonical.h"
+#include "dualcomplex_hash.h"
+#include "dualcomplex_expression.h"
+#include "dualcomplex_mixed_precision.h"
+#include "dualcomplex_fixed_point.h"
+#include "dualcomplex_instrumentation.h"
+#include "dualcomplex_health.h"
+#include "dualcomplex_outer.h"
+#include "dualcomplex_allocator.h"
+#include "dualcomplex_pipeline.h"
+#include "dualcomplex_channel.h"
+#include "dualcomplex_pose_interpolant.h"
+#include "dualcomplex_pose_buffer.h"
+#include "dualcomplex_deskew.h"
+#include "dualcomplex_collision.h"
+#include "dualcomplex_trajectory.h"
+#include "dualcomplex_hermite.h"
+#include "dualcomplex_simplify.h"
+#include "dualcomplex_random.h"
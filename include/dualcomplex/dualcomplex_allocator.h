@@ -0,0 +1,404 @@
+/**
+ * @file dualcomplex/dualcomplex_allocator.h
+ * @brief This file provides aligned arena and pool allocators for dual complex buffers.
+ *
+ * A FrameArena serves the scratch buffers of one frame and releases them all at once:
+ *
+ *     dcn::FrameArena arena;
+ *     for(;;)
+ *     {
+ *         dcn::ArenaVector<dcn::DualComplex<float>> poses{ dcn::ArenaAllocator<dcn::DualComplex<float>>(arena) };
+ *         ...
+ *         arena.reset();   // After every container using the arena is gone.
+ *     }
+ *
+ * PoolAllocator recycles blocks through a free list per size class owned by the calling thread,
+ * for containers whose lifetime does not follow the frame.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace dcn
+{
+
+namespace detail
+{
+
+/**
+ * Allocates memory aligned to a power of two, to be released with aligned_deallocate().
+ * The pointer returned by operator new is stored just before the aligned block.
+ */
+inline void*
+aligned_allocate(std::size_t bytes, std::size_t alignment)
+{
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    if(bytes > std::numeric_limits<std::size_t>::max() - alignment - sizeof(void*))
+        throw std::bad_alloc();
+
+    const auto raw = ::operator new(bytes + alignment + sizeof(void*));
+    auto address = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+    address = (address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    const auto res = reinterpret_cast<void**>(address);
+    res[-1] = raw;
+    return res;
+}
+
+inline void
+aligned_deallocate(void* p) noexcept
+{
+    if(p)
+        ::operator delete(static_cast<void**>(p)[-1]);
+}
+
+}   // namespace detail
+
+/**
+ * Bump allocator whose allocations are all released together by reset().
+ *
+ * When a frame needs more than the capacity, further blocks are added,
+ * and reset() merges them into one block so that later frames do not allocate at all.
+ */
+class FrameArena
+{
+public:
+/* Constructors */
+    explicit FrameArena(std::size_t capacity = 1u << 20)
+        : offset_(0), used_(0)
+    {
+        add_block(std::max<std::size_t>(capacity, 1));
+    }
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator = (const FrameArena&) = delete;
+
+    ~FrameArena()
+    {
+        for(const auto& block : blocks_)
+            detail::aligned_deallocate(block.data);
+    }
+
+/* Accessors */
+    /**
+     * Returns the total size of the blocks.
+     */
+    std::size_t capacity() const noexcept
+    {
+        std::size_t res = 0;
+        for(const auto& block : blocks_)
+            res += block.size;
+        return res;
+    }
+
+    /**
+     * Returns the bytes handed out since the last reset, including alignment padding.
+     */
+    std::size_t used() const noexcept { return used_; }
+
+/* Modifiers */
+    /**
+     * Returns uninitialized memory aligned to a power of two, valid until the next reset().
+     */
+    void* allocate(std::size_t bytes, std::size_t alignment)
+    {
+        assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+        auto res = try_allocate(bytes, alignment);
+        if(!res)
+        {
+            add_block(std::max(2 * blocks_.back().size, bytes + alignment));
+            res = try_allocate(bytes, alignment);
+            assert(res);
+        }
+        return res;
+    }
+
+    /**
+     * Releases every allocation at once.
+     * If merging the blocks fails to allocate, the arena is left unchanged.
+     */
+    void reset()
+    {
+        if(blocks_.size() > 1)
+        {
+            const auto total = capacity();
+            std::vector<Block> blocks;
+            blocks.reserve(1);
+            const Block block = { static_cast<char*>(detail::aligned_allocate(total, block_alignment)), total };
+            blocks.push_back(block);
+            blocks_.swap(blocks);
+            for(const auto& old : blocks)
+                detail::aligned_deallocate(old.data);
+        }
+        offset_ = 0;
+        used_ = 0;
+    }
+
+private:
+    struct Block
+    {
+        char* data;
+        std::size_t size;
+    };
+
+    static constexpr std::size_t block_alignment = 64;
+
+    void add_block(std::size_t size)
+    {
+        blocks_.reserve(blocks_.size() + 1);
+        const Block block = { static_cast<char*>(detail::aligned_allocate(size, block_alignment)), size };
+        blocks_.push_back(block);
+        offset_ = 0;
+    }
+
+    void* try_allocate(std::size_t bytes, std::size_t alignment)
+    {
+        const auto& block = blocks_.back();
+        const auto base = reinterpret_cast<std::uintptr_t>(block.data);
+        const auto address = (base + offset_ + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+        const auto begin = static_cast<std::size_t>(address - base);
+        if(begin > block.size || bytes > block.size - begin)
+            return nullptr;
+
+        used_ += begin + bytes - offset_;
+        offset_ = begin + bytes;
+        return block.data + begin;
+    }
+
+    std::vector<Block> blocks_;
+    std::size_t offset_;    // In the last block.
+    std::size_t used_;
+};
+
+/**
+ * Standard allocator drawing from a FrameArena, where deallocation does nothing.
+ * Containers using it must be destroyed or cleared before the arena is reset.
+ */
+template<typename T, std::size_t Alignment = 64>
+class ArenaAllocator
+{
+    static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two.");
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = ArenaAllocator<U, Alignment>;
+    };
+
+/* Constructors */
+    explicit ArenaAllocator(FrameArena& arena) noexcept
+        : arena_(&arena)
+    {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U, Alignment>& other) noexcept
+        : arena_(other.arena())
+    {}
+
+/* Accessors */
+    FrameArena* arena() const noexcept { return arena_; }
+
+/* Operations */
+    T* allocate(std::size_t n)
+    {
+        if(n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+        constexpr auto alignment = (Alignment < alignof(T)) ? alignof(T) : Alignment;
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignment));
+    }
+
+    void deallocate(T*, std::size_t) noexcept
+    {}
+
+private:
+    FrameArena* arena_;
+};
+
+template<typename T, typename U, std::size_t Alignment>
+bool
+operator == (const ArenaAllocator<T, Alignment>& lhs, const ArenaAllocator<U, Alignment>& rhs) noexcept
+{
+    return lhs.arena() == rhs.arena();
+}
+
+template<typename T, typename U, std::size_t Alignment>
+bool
+operator != (const ArenaAllocator<T, Alignment>& lhs, const ArenaAllocator<U, Alignment>& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+namespace detail
+{
+
+/**
+ * Free lists of 64-byte aligned blocks, one per power-of-two size class.
+ * Blocks larger than the biggest class bypass the pool.
+ *
+ * The lists are intrusive: a free block stores the next one in its first bytes,
+ * so that returning a block never allocates.
+ */
+class ThreadLocalPool
+{
+public:
+    static constexpr std::size_t alignment = 64;
+    static constexpr std::size_t min_class = 6;     // 64 bytes.
+    static constexpr std::size_t max_class = 24;    // 16 MiB.
+
+    ThreadLocalPool() noexcept
+        : free_()
+    {}
+
+    ThreadLocalPool(const ThreadLocalPool&) = delete;
+    ThreadLocalPool& operator = (const ThreadLocalPool&) = delete;
+
+    ~ThreadLocalPool()
+    {
+        release();
+    }
+
+    void* allocate(std::size_t bytes)
+    {
+        const auto c = size_class(bytes);
+        if(c > max_class)
+            return aligned_allocate(bytes, alignment);
+
+        auto& head = free_[c - min_class];
+        if(!head)
+            return aligned_allocate(static_cast<std::size_t>(1) << c, alignment);
+
+        const auto res = head;
+        head = head->next;
+        return res;
+    }
+
+    void deallocate(void* p, std::size_t bytes) noexcept
+    {
+        const auto c = size_class(bytes);
+        if(c > max_class)
+        {
+            aligned_deallocate(p);
+        }
+        else
+        {
+            const auto node = ::new(p) FreeNode;
+            node->next = free_[c - min_class];
+            free_[c - min_class] = node;
+        }
+    }
+
+    /**
+     * Returns the cached blocks to the system.
+     */
+    void release() noexcept
+    {
+        for(auto& head : free_)
+        {
+            while(head)
+            {
+                const auto next = head->next;
+                aligned_deallocate(head);
+                head = next;
+            }
+        }
+    }
+
+private:
+    struct FreeNode
+    {
+        FreeNode* next;
+    };
+
+    static std::size_t size_class(std::size_t bytes) noexcept
+    {
+        auto c = min_class;
+        while(c <= max_class && (static_cast<std::size_t>(1) << c) < bytes)
+            c++;
+        return c;
+    }
+
+    FreeNode* free_[max_class - min_class + 1];
+};
+
+inline ThreadLocalPool&
+thread_local_pool()
+{
+    static thread_local ThreadLocalPool pool;
+    return pool;
+}
+
+}   // namespace detail
+
+/**
+ * Standard allocator backed by a pool of 64-byte aligned blocks owned by the calling thread,
+ * so that threads do not contend on the global allocator.
+ *
+ * A block freed on another thread joins that thread's pool.
+ * Containers using it must not outlive the threads that allocate or free their storage.
+ */
+template<typename T>
+class PoolAllocator
+{
+    static_assert(alignof(T) <= detail::ThreadLocalPool::alignment, "T is over-aligned.");
+public:
+    using value_type = T;
+
+/* Constructors */
+    PoolAllocator() = default;
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept
+    {}
+
+/* Operations */
+    T* allocate(std::size_t n)
+    {
+        if(n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+        return static_cast<T*>(detail::thread_local_pool().allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        detail::thread_local_pool().deallocate(p, n * sizeof(T));
+    }
+};
+
+template<typename T, typename U>
+bool
+operator == (const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept
+{
+    return true;
+}
+
+template<typename T, typename U>
+bool
+operator != (const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept
+{
+    return false;
+}
+
+/**
+ * Returns the blocks cached by the calling thread's pool to the system.
+ */
+inline void
+release_thread_pool() noexcept
+{
+    detail::thread_local_pool().release();
+}
+
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+template<typename T>
+using PoolVector = std::vector<T, PoolAllocator<T>>;
+
+}   // namespace dcn
@@ -4,15 +4,25 @@
 #pragma once
 
 #include <complex>
+#include <type_traits>
 
 namespace dcn
 {
 
+/**
+ * Scalar types allowed as the template parameter of DualComplex.
+ * Specialized for the fixed-point types of dualcomplex_fixed_point.h.
+ */
+template<typename T>
+struct is_dual_complex_scalar
+    : std::is_floating_point<T>
+{};
+
 template<typename T>
 class DualComplex
 {
-    static_assert(std::is_floating_point<T>::value,
-        "Template parameter T must be floating_point type.");
+    static_assert(is_dual_complex_scalar<T>::value,
+        "Template parameter T must be floating_point or fixed-point type.");
 public:
     using value_type = T;
 
@@ -42,6 +52,16 @@ public:
         : DualComplex(std::complex<T>(static_cast<T>(1), static_cast<T>(0)), v)
     {}
 
+    /**
+     * Constructs a dual complex number from one of another precision.
+     */
+    template<typename U>
+    explicit DualComplex(const DualComplex<U>& other)
+        : DualComplex(
+            static_cast<T>(other.real().real()), static_cast<T>(other.real().imag()),
+            static_cast<T>(other.dual().real()), static_cast<T>(other.dual().imag()))
+    {}
+
 /* Accessors */
     const std::complex<T>& real() const noexcept { return real_; }
     const std::complex<T>& dual() const noexcept { return dual_; }
@@ -0,0 +1,287 @@
+/**
+ * @file dualcomplex/dualcomplex_batch_query.h
+ * @brief This file provides bulk relational and query functions for dual complex types.
+ *
+ * Each function evaluates a predicate over count elements without short-circuiting,
+ * optionally writes the results as a packed bitmask (bit i % 64 of word i / 64),
+ * and returns the number of elements for which the predicate holds.
+ * The mask may be null when only the count is needed.
+ */
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "dualcomplex_soa.h"
+
+namespace dcn
+{
+
+namespace detail
+{
+
+/**
+ * Branch-free counterpart of almost_equal.
+ */
+template<typename T>
+inline bool
+almost_equal_branchless(T lhs, T rhs, T tolerance)
+{
+    const auto a = std::abs(lhs);
+    const auto b = std::abs(rhs);
+    const auto m = (a < b) ? b : a;
+    const auto scale = (m < static_cast<T>(1)) ? static_cast<T>(1) : m;
+    return std::abs(lhs - rhs) <= tolerance * scale;
+}
+
+template<typename T>
+inline bool
+almost_zero_branchless(T x, T tolerance)
+{
+    return std::abs(x) <= tolerance;
+}
+
+inline std::size_t
+popcount(std::uint64_t x)
+{
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<std::size_t>((x * 0x0101010101010101ull) >> 56);
+}
+
+/**
+ * Evaluates pred(i) for every index and packs the results 64 at a time.
+ */
+template<typename Pred>
+std::size_t
+evaluate_mask(std::size_t count, std::uint64_t* mask, Pred pred)
+{
+    std::size_t total = 0;
+    for(std::size_t base = 0; base < count; base += 64)
+    {
+        const auto n = (count - base < 64) ? count - base : static_cast<std::size_t>(64);
+        std::uint64_t bits = 0;
+        for(std::size_t j = 0; j < n; j++)
+            bits |= static_cast<std::uint64_t>(pred(base + j)) << j;
+
+        if(mask)
+            mask[base / 64] = bits;
+        total += popcount(bits);
+    }
+    return total;
+}
+
+template<typename T>
+inline bool
+almost_equal_components(T a0, T b0, T c0, T d0, T a1, T b1, T c1, T d1, T tolerance)
+{
+    return almost_equal_branchless(a0, a1, tolerance)
+         & almost_equal_branchless(b0, b1, tolerance)
+         & almost_equal_branchless(c0, c1, tolerance)
+         & almost_equal_branchless(d0, d1, tolerance);
+}
+
+template<typename T>
+inline bool
+are_same_components(T a0, T b0, T c0, T d0, T a1, T b1, T c1, T d1, T tolerance)
+{
+    return almost_equal_components(a0, b0, c0, d0, a1, b1, c1, d1, tolerance)
+         | almost_equal_components(a0, b0, c0, d0,-a1,-b1,-c1,-d1, tolerance);
+}
+
+template<typename T>
+inline bool
+almost_zero_components(T a, T b, T c, T d, T tolerance)
+{
+    return almost_zero_branchless(a, tolerance)
+         & almost_zero_branchless(b, tolerance)
+         & almost_zero_branchless(c, tolerance)
+         & almost_zero_branchless(d, tolerance);
+}
+
+template<typename T>
+inline bool
+is_identity_components(T a, T b, T c, T d, T tolerance)
+{
+    return almost_equal_branchless(a, static_cast<T>(1), tolerance)
+         & almost_zero_branchless(b, tolerance)
+         & almost_zero_branchless(c, tolerance)
+         & almost_zero_branchless(d, tolerance);
+}
+
+template<typename T>
+inline bool
+is_unit_components(T a, T b, T tolerance)
+{
+    return almost_equal_branchless(a * a + b * b, static_cast<T>(1), tolerance);
+}
+
+}   // namespace detail
+
+/**
+ * Returns the number of 64-bit words needed for a mask of count elements.
+ */
+constexpr std::size_t
+mask_words(std::size_t count)
+{
+    return (count + 63) / 64;
+}
+
+/**
+ * Returns the index of the first clear bit of a mask, or count if all bits are set.
+ */
+inline std::size_t
+find_first_unset(const std::uint64_t* mask, std::size_t count)
+{
+    for(std::size_t w = 0; w < mask_words(count); w++)
+    {
+        const auto unset = ~mask[w];
+        if(unset == 0)
+            continue;
+
+        const auto index = w * 64 + detail::popcount((unset & (~unset + 1)) - 1);
+        return (index < count) ? index : count;
+    }
+    return count;
+}
+
+/* Array of structures */
+
+template<typename T>
+std::size_t
+batch_almost_equal(
+    const DualComplex<T>* lhs, const DualComplex<T>* rhs, std::size_t count, T tolerance, std::uint64_t* mask)
+{
+    return detail::evaluate_mask(count, mask,
+        [=](std::size_t i)
+        {
+            return detail::almost_equal_components(
+                lhs[i].real().real(), lhs[i].real().imag(), lhs[i].dual().real(), lhs[i].dual().imag(),
+                rhs[i].real().real(), rhs[i].real().imag(), rhs[i].dual().real(), rhs[i].dual().imag(),
+                tolerance);
+        });
+}
+
+template<typename T>
+std::size_t
+batch_almost_zero(const DualComplex<T>* dcs, std::size_t count, T tolerance, std::uint64_t* mask)
+{
+    return detail::evaluate_mask(count, mask,
+        [=](std::size_t i)
+        {
+            return detail::almost_zero_components(
+                dcs[i].real().real(), dcs[i].real().imag(), dcs[i].dual().real(), dcs[i].dual().imag(),
+                tolerance);
+        });
+}
+
+template<typename T>
+std::size_t
+batch_is_identity(const DualComplex<T>* dcs, std::size_t count, T tolerance, std::uint64_t* mask)
+{
+    return detail::evaluate_mask(count, mask,
+        [=](std::size_t i)
+        {
+            return detail::is_identity_components(
+                dcs[i].real().real(), dcs[i].real().imag(), dcs[i].dual().real(), dcs[i].dual().imag(),
+                tolerance);
+        });
+}
+
+template<typename T>
+std::size_t
+batch_is_unit(const DualComplex<T>* dcs, std::size_t count, T tolerance, std::uint64_t* mask)
+{
+    return detail::evaluate_mask(count, mask,
+        [=](std::size_t i)
+        {
+            return detail::is_unit_components(dcs[i].real().real(), dcs[i].real().imag(), tolerance);
+        });
+}
+
+/**
+ * Unlike are_same, the inputs are not asserted to be unit dual complex numbers.
+ */
+template<typename T>
+std::size_t
+batch_are_same(
+    const DualComplex<T>* lhs, const DualComplex<T>* rhs, std::size_t count, T tolerance, std::uint64_t* mask)
+{
+    return detail::evaluate_mask(count, mask,
+        [=](std::size_t i)
+        {
+            return detail::are_same_components(
+                lhs[i].real().real(), lhs[i].real().imag(), lhs[i].dual().real(), lhs[i].dual().imag(),
+                rhs[i].real().real(), rhs[i].real().imag(), rhs[i].dual().real(), rhs[i].dual().imag(),
+                tolerance);
+        });
+}
+
+/* Structure of arrays */
+
+template<typename T, typename A1, typename A2>
+std::size_t
+batch_almost_equal(const DualComplexSoA<T, A1>& lhs, const DualComplexSoA<T, A2>& rhs, T tolerance, std::uint64_t* mask)
+{
+    assert(lhs.size() == rhs.size());
+    const auto a0 = lhs.real_real(); const auto b0 = lhs.real_imag();
+    const auto c0 = lhs.dual_real(); const auto d0 = lhs.dual_imag();
+    const auto a1 = rhs.real_real(); const auto b1 = rhs.real_imag();
+    const auto c1 = rhs.dual_real(); const auto d1 = rhs.dual_imag();
+    return detail::evaluate_mask(lhs.size(), mask,
+        [=](std::size_t i)
+        {
+            return detail::almost_equal_components(
+                a0[i], b0[i], c0[i], d0[i], a1[i], b1[i], c1[i], d1[i], tolerance);
+        });
+}
+
+template<typename T, typename A>
+std::size_t
+batch_almost_zero(const DualComplexSoA<T, A>& dcs, T tolerance, std::uint64_t* mask)
+{
+    const auto a = dcs.real_real(); const auto b = dcs.real_imag();
+    const auto c = dcs.dual_real(); const auto d = dcs.dual_imag();
+    return detail::evaluate_mask(dcs.size(), mask,
+        [=](std::size_t i){ return detail::almost_zero_components(a[i], b[i], c[i], d[i], tolerance); });
+}
+
+template<typename T, typename A>
+std::size_t
+batch_is_identity(const DualComplexSoA<T, A>& dcs, T tolerance, std::uint64_t* mask)
+{
+    const auto a = dcs.real_real(); const auto b = dcs.real_imag();
+    const auto c = dcs.dual_real(); const auto d = dcs.dual_imag();
+    return detail::evaluate_mask(dcs.size(), mask,
+        [=](std::size_t i){ return detail::is_identity_components(a[i], b[i], c[i], d[i], tolerance); });
+}
+
+template<typename T, typename A>
+std::size_t
+batch_is_unit(const DualComplexSoA<T, A>& dcs, T tolerance, std::uint64_t* mask)
+{
+    const auto a = dcs.real_real(); const auto b = dcs.real_imag();
+    return detail::evaluate_mask(dcs.size(), mask,
+        [=](std::size_t i){ return detail::is_unit_components(a[i], b[i], tolerance); });
+}
+
+template<typename T, typename A1, typename A2>
+std::size_t
+batch_are_same(const DualComplexSoA<T, A1>& lhs, const DualComplexSoA<T, A2>& rhs, T tolerance, std::uint64_t* mask)
+{
+    assert(lhs.size() == rhs.size());
+    const auto a0 = lhs.real_real(); const auto b0 = lhs.real_imag();
+    const auto c0 = lhs.dual_real(); const auto d0 = lhs.dual_imag();
+    const auto a1 = rhs.real_real(); const auto b1 = rhs.real_imag();
+    const auto c1 = rhs.dual_real(); const auto d1 = rhs.dual_imag();
+    return detail::evaluate_mask(lhs.size(), mask,
+        [=](std::size_t i)
+        {
+            return detail::are_same_components(
+                a0[i], b0[i], c0[i], d0[i], a1[i], b1[i], c1[i], d1[i], tolerance);
+        });
+}
+
+}   // namespace dcn
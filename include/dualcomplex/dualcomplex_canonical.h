@@ -0,0 +1,127 @@
+/**
+ * @file dualcomplex/dualcomplex_canonical.h
+ * @brief This file provides a canonical sign form for dual complex types.
+ */
+#pragma once
+
+#include <complex>
+#include "dualcomplex_common.h"
+#include "dualcomplex_transform.h"
+#include "dualcomplex_relational.h"
+
+namespace dcn
+{
+
+/**
+ * Returns true if a dual complex number is the canonical one of dc and -dc,
+ * that is the real part of its real part is positive, or zero with a non-negative imaginary part.
+ */
+template<typename T>
+bool
+is_canonical(const DualComplex<T>& dc)
+{
+    const auto& r = dc.real();
+    return (r.real() > static_cast<T>(0))
+        || (r.real() == static_cast<T>(0) && !(r.imag() < static_cast<T>(0)));
+}
+
+/**
+ * Returns the canonical one of dc and -dc, the representative closest to the identity.
+ */
+template<typename T>
+DualComplex<T>
+canonicalize(const DualComplex<T>& dc)
+{
+    return is_canonical(dc) ? dc : -dc;
+}
+
+/**
+ * Unit dual complex number kept in canonical sign form, so that a transformation has a single representation.
+ *
+ * Equality and hashing need a single test. Interpolation still needs slerp_shortestpath,
+ * since two canonical values may lie more than a quarter turn apart on the unit circle.
+ */
+template<typename T>
+class CanonicalDualComplex
+{
+public:
+    using value_type = T;
+
+/* Constructors */
+    CanonicalDualComplex()
+        : value_(std::complex<T>(static_cast<T>(1), static_cast<T>(0)), std::complex<T>(static_cast<T>(0), static_cast<T>(0)))
+    {}
+
+    explicit CanonicalDualComplex(const DualComplex<T>& dc)
+        : value_(canonicalize(dc))
+    {}
+
+/* Accessors */
+    const DualComplex<T>& value() const noexcept { return value_; }
+    const std::complex<T>& real() const noexcept { return value_.real(); }
+    const std::complex<T>& dual() const noexcept { return value_.dual(); }
+
+    operator const DualComplex<T>& () const noexcept { return value_; }
+
+/* Assignment operators */
+    CanonicalDualComplex& operator *= (const CanonicalDualComplex& rhs)
+    {
+        value_ = canonicalize(value_ * rhs.value_);
+        return *this;
+    }
+
+private:
+    DualComplex<T> value_;
+};
+
+template<typename T>
+CanonicalDualComplex<T>
+operator * (const CanonicalDualComplex<T>& lhs, const CanonicalDualComplex<T>& rhs)
+{
+    return CanonicalDualComplex<T>(lhs.value() * rhs.value());
+}
+
+template<typename T>
+bool
+operator == (const CanonicalDualComplex<T>& lhs, const CanonicalDualComplex<T>& rhs)
+{
+    return lhs.real() == rhs.real() && lhs.dual() == rhs.dual();
+}
+
+template<typename T>
+bool
+operator != (const CanonicalDualComplex<T>& lhs, const CanonicalDualComplex<T>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template<typename T>
+CanonicalDualComplex<T>
+inverse(const CanonicalDualComplex<T>& dc)
+{
+    return CanonicalDualComplex<T>(total_conjugate(dc.value()));
+}
+
+template<typename T>
+std::complex<T>
+transform(const CanonicalDualComplex<T>& p, const std::complex<T>& v)
+{
+    return transform(p.value(), v);
+}
+
+/**
+ * Returns true if the two canonical dual complex numbers represent the same transformation.
+ * The negated comparison is only needed near a half turn, where rounding may pick either sign.
+ */
+template<typename T>
+bool
+are_same(const CanonicalDualComplex<T>& dc0, const CanonicalDualComplex<T>& dc1, T tolerance)
+{
+    if(almost_equal(dc0.value(), dc1.value(), tolerance))
+        return true;
+    if(!detail::almost_zero(dc0.real().real(), tolerance))
+        return false;
+    return almost_equal(dc0.value(), -dc1.value(), tolerance);
+}
+
+}   // namespace dcn
@@ -0,0 +1,126 @@
+/**
+ * @file dualcomplex/dualcomplex_channel.h
+ * @brief This file provides lock-free publication of the latest pose for dual complex types.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "dualcomplex_base.h"
+
+namespace dcn
+{
+
+/**
+ * Channel through which one writer thread publishes the latest value of Count poses to any number of readers.
+ *
+ * The writer cycles through Slots seqlock-protected buffers, so that neither side ever blocks.
+ * A read only retries when the writer publishes Slots times while the read is in progress.
+ * The components are stored as relaxed atomics, so that concurrent reads and writes are not data races.
+ */
+template<typename T, std::size_t Count = 1, std::size_t Slots = 4>
+class PoseChannel
+{
+    static_assert(Count > 0, "Count must be positive.");
+    static_assert(Slots > 1, "Slots must be at least two.");
+public:
+    using value_type = T;
+    using version_type = std::uint64_t;
+
+/* Constructors */
+    PoseChannel()
+        : latest_(0)
+    {
+        for(auto& slot : slots_)
+            slot.sequence.store(0, std::memory_order_relaxed);
+    }
+
+    PoseChannel(const PoseChannel&) = delete;
+    PoseChannel& operator = (const PoseChannel&) = delete;
+
+/* Accessors */
+    /**
+     * Returns the number of publications so far.
+     */
+    version_type version() const noexcept { return latest_.load(std::memory_order_acquire); }
+
+/* Modifiers */
+    /**
+     * Publishes Count poses. Must only be called from the writer thread.
+     */
+    void publish(const DualComplex<T>* poses) noexcept
+    {
+        const auto v = latest_.load(std::memory_order_relaxed) + 1;
+        auto& slot = slots_[v % Slots];
+
+        slot.sequence.store(2 * v - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for(std::size_t i = 0; i < Count; i++)
+        {
+            slot.components[4 * i + 0].store(poses[i].real().real(), std::memory_order_relaxed);
+            slot.components[4 * i + 1].store(poses[i].real().imag(), std::memory_order_relaxed);
+            slot.components[4 * i + 2].store(poses[i].dual().real(), std::memory_order_relaxed);
+            slot.components[4 * i + 3].store(poses[i].dual().imag(), std::memory_order_relaxed);
+        }
+        slot.sequence.store(2 * v, std::memory_order_release);
+        latest_.store(v, std::memory_order_release);
+    }
+
+    void publish(const DualComplex<T>& pose) noexcept
+    {
+        static_assert(Count == 1, "Use publish(const DualComplex<T>*) for Count > 1.");
+        publish(&pose);
+    }
+
+/* Operations */
+    /**
+     * Copies the latest Count poses and returns their version, or returns zero if nothing has been published.
+     */
+    version_type read(DualComplex<T>* poses) const noexcept
+    {
+        for(;;)
+        {
+            const auto v = latest_.load(std::memory_order_acquire);
+            if(v == 0)
+                return 0;
+
+            const auto& slot = slots_[v % Slots];
+            const auto before = slot.sequence.load(std::memory_order_acquire);
+            if(before != 2 * v)
+                continue;
+
+            for(std::size_t i = 0; i < Count; i++)
+            {
+                poses[i] = DualComplex<T>(
+                    slot.components[4 * i + 0].load(std::memory_order_relaxed),
+                    slot.components[4 * i + 1].load(std::memory_order_relaxed),
+                    slot.components[4 * i + 2].load(std::memory_order_relaxed),
+                    slot.components[4 * i + 3].load(std::memory_order_relaxed));
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(slot.sequence.load(std::memory_order_relaxed) == before)
+                return v;
+        }
+    }
+
+    version_type read(DualComplex<T>& pose) const noexcept
+    {
+        static_assert(Count == 1, "Use read(DualComplex<T>*) for Count > 1.");
+        return read(&pose);
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<version_type> sequence;     // Odd while being written.
+        std::atomic<T> components[4 * Count];
+        char padding[64];                       // Keeps the next slot off this slot's last cache line.
+    };
+
+    std::atomic<version_type> latest_;
+    char padding_[64];
+    Slot slots_[Slots];
+};
+
+}   // namespace dcn
@@ -0,0 +1,395 @@
+/**
+ * @file dualcomplex/dualcomplex_collision.h
+ * @brief This file provides overlap and distance queries for shapes posed by dual complex types.
+ *
+ * Shapes are defined in their local frame and placed by a unit dual complex pose,
+ * which is expanded to its rotation and translation once per shape and query.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "dualcomplex_base.h"
+
+namespace dcn
+{
+
+template<typename T>
+struct Circle
+{
+    T radius;
+
+    explicit Circle(T r)
+        : radius(r)
+    {}
+};
+
+/**
+ * Rectangle centered at the origin of its frame.
+ */
+template<typename T>
+struct Box
+{
+    T half_width;
+    T half_height;
+
+    Box(T w, T h)
+        : half_width(w), half_height(h)
+    {}
+};
+
+/**
+ * Segment from (-half_length, 0) to (half_length, 0) swept by a circle.
+ */
+template<typename T>
+struct Capsule
+{
+    T half_length;
+    T radius;
+
+    Capsule(T l, T r)
+        : half_length(l), radius(r)
+    {}
+};
+
+/**
+ * Axis-aligned bounding box.
+ */
+template<typename T>
+struct Aabb
+{
+    std::complex<T> min;
+    std::complex<T> max;
+};
+
+namespace detail
+{
+
+/**
+ * A shape as a point, a segment or a rectangle in world coordinates, dilated by a radius.
+ */
+template<typename T>
+struct ShapeCore
+{
+    std::complex<T> vertices[4];
+    std::size_t count;
+    T radius;
+};
+
+template<typename T>
+void
+pose_affine(const DualComplex<T>& pose, std::complex<T>& rotation, std::complex<T>& translation)
+{
+    rotation = pose.real() * pose.real();
+    translation = static_cast<T>(2) * pose.real() * pose.dual();
+}
+
+template<typename T>
+ShapeCore<T>
+make_core(const Circle<T>& circle, const DualComplex<T>& pose)
+{
+    std::complex<T> rotation, translation;
+    pose_affine(pose, rotation, translation);
+
+    ShapeCore<T> res;
+    res.vertices[0] = translation;
+    res.count = 1;
+    res.radius = circle.radius;
+    return res;
+}
+
+template<typename T>
+ShapeCore<T>
+make_core(const Box<T>& box, const DualComplex<T>& pose)
+{
+    std::complex<T> rotation, translation;
+    pose_affine(pose, rotation, translation);
+
+    const auto x = rotation * box.half_width;
+    const auto y = rotation * std::complex<T>(static_cast<T>(0), box.half_height);
+    ShapeCore<T> res;
+    res.vertices[0] = translation - x - y;
+    res.vertices[1] = translation + x - y;
+    res.vertices[2] = translation + x + y;
+    res.vertices[3] = translation - x + y;
+    res.count = 4;
+    res.radius = static_cast<T>(0);
+    return res;
+}
+
+template<typename T>
+ShapeCore<T>
+make_core(const Capsule<T>& capsule, const DualComplex<T>& pose)
+{
+    std::complex<T> rotation, translation;
+    pose_affine(pose, rotation, translation);
+
+    const auto x = rotation * capsule.half_length;
+    ShapeCore<T> res;
+    res.vertices[0] = translation - x;
+    res.vertices[1] = translation + x;
+    res.count = 2;
+    res.radius = capsule.radius;
+    return res;
+}
+
+template<typename T>
+T
+dot(const std::complex<T>& a, const std::complex<T>& b)
+{
+    return a.real() * b.real() + a.imag() * b.imag();
+}
+
+/**
+ * Returns the distance between the segments [p0, p1] and [q0, q1], either of which may be a point.
+ */
+template<typename T>
+T
+segment_distance(const std::complex<T>& p0, const std::complex<T>& p1, const std::complex<T>& q0, const std::complex<T>& q1)
+{
+    constexpr auto zero = static_cast<T>(0);
+    constexpr auto one = static_cast<T>(1);
+
+    const auto d0 = p1 - p0;
+    const auto d1 = q1 - q0;
+    const auto r = p0 - q0;
+    const auto a = std::norm(d0);
+    const auto e = std::norm(d1);
+    const auto f = dot(d1, r);
+
+    T s, t;
+    if(a <= zero && e <= zero)
+        return std::abs(r);
+    if(a <= zero)
+    {
+        s = zero;
+        t = std::min(std::max(f / e, zero), one);
+    }
+    else
+    {
+        const auto c = dot(d0, r);
+        if(e <= zero)
+        {
+            t = zero;
+            s = std::min(std::max(-c / a, zero), one);
+        }
+        else
+        {
+            const auto b = dot(d0, d1);
+            const auto denom = a * e - b * b;
+            s = (denom > zero) ? std::min(std::max((b * f - c * e) / denom, zero), one) : zero;
+            t = (b * s + f) / e;
+            if(t < zero)
+            {
+                t = zero;
+                s = std::min(std::max(-c / a, zero), one);
+            }
+            else if(t > one)
+            {
+                t = one;
+                s = std::min(std::max((b - c) / a, zero), one);
+            }
+        }
+    }
+    return std::abs((p0 + d0 * s) - (q0 + d1 * t));
+}
+
+/**
+ * Appends the unit separating axis candidates of a core.
+ */
+template<typename T>
+void
+append_axes(const ShapeCore<T>& core, std::complex<T>* axes, std::size_t& count)
+{
+    if(core.count == 1)
+        return;
+
+    const auto i = std::complex<T>(static_cast<T>(0), static_cast<T>(1));
+    for(std::size_t k = 0; k < 2; k++)
+    {
+        const auto edge = core.vertices[k + 1] - core.vertices[k];
+        const auto length = std::abs(edge);
+        if(length <= static_cast<T>(0))
+            continue;
+        // A segment needs its direction as well, for collinear configurations.
+        axes[count++] = i * edge / length;
+        if(core.count == 2)
+        {
+            axes[count++] = edge / length;
+            return;
+        }
+    }
+}
+
+template<typename T>
+void
+project(const ShapeCore<T>& core, const std::complex<T>& axis, T& lo, T& hi)
+{
+    lo = hi = dot(core.vertices[0], axis);
+    for(std::size_t k = 1; k < core.count; k++)
+    {
+        const auto x = dot(core.vertices[k], axis);
+        lo = std::min(lo, x);
+        hi = std::max(hi, x);
+    }
+}
+
+/**
+ * Signed distance between the undilated cores, negative by the penetration depth when they intersect.
+ */
+template<typename T>
+T
+core_distance(const ShapeCore<T>& a, const ShapeCore<T>& b)
+{
+    std::complex<T> axes[4];
+    std::size_t num_axes = 0;
+    append_axes(a, axes, num_axes);
+    append_axes(b, axes, num_axes);
+
+    auto separated = (num_axes == 0);
+    auto depth = std::numeric_limits<T>::max();
+    for(std::size_t k = 0; k < num_axes && !separated; k++)
+    {
+        T a_lo, a_hi, b_lo, b_hi;
+        project(a, axes[k], a_lo, a_hi);
+        project(b, axes[k], b_lo, b_hi);
+        const auto overlap = std::min(a_hi - b_lo, b_hi - a_lo);
+        if(overlap < static_cast<T>(0))
+            separated = true;
+        else
+            depth = std::min(depth, overlap);
+    }
+    if(!separated)
+        return -depth;
+
+    // The closest points of disjoint convex sets lie on their edges.
+    auto res = std::numeric_limits<T>::max();
+    const std::size_t a_edges = (a.count == 4) ? 4 : 1;
+    const std::size_t b_edges = (b.count == 4) ? 4 : 1;
+    for(std::size_t i = 0; i < a_edges; i++)
+    {
+        const auto& p0 = a.vertices[i];
+        const auto& p1 = a.vertices[(a.count == 1) ? 0 : (i + 1) % a.count];
+        for(std::size_t j = 0; j < b_edges; j++)
+        {
+            const auto& q0 = b.vertices[j];
+            const auto& q1 = b.vertices[(b.count == 1) ? 0 : (j + 1) % b.count];
+            res = std::min(res, segment_distance(p0, p1, q0, q1));
+        }
+    }
+    return res;
+}
+
+}   // namespace detail
+
+/**
+ * Returns the distance between two posed shapes, or the negated penetration depth if they overlap.
+ */
+template<typename S0, typename S1, typename T>
+T
+signed_distance(const S0& shape0, const DualComplex<T>& pose0, const S1& shape1, const DualComplex<T>& pose1)
+{
+    const auto a = detail::make_core(shape0, pose0);
+    const auto b = detail::make_core(shape1, pose1);
+    return detail::core_distance(a, b) - a.radius - b.radius;
+}
+
+/**
+ * Returns true if two posed shapes overlap or touch.
+ */
+template<typename S0, typename S1, typename T>
+bool
+overlap(const S0& shape0, const DualComplex<T>& pose0, const S1& shape1, const DualComplex<T>& pose1)
+{
+    return signed_distance(shape0, pose0, shape1, pose1) <= static_cast<T>(0);
+}
+
+/**
+ * Returns the axis-aligned bounding box of a posed shape.
+ */
+template<typename S, typename T>
+Aabb<T>
+aabb(const S& shape, const DualComplex<T>& pose)
+{
+    const auto core = detail::make_core(shape, pose);
+    Aabb<T> res;
+    res.min = res.max = core.vertices[0];
+    for(std::size_t k = 1; k < core.count; k++)
+    {
+        const auto& v = core.vertices[k];
+        res.min = std::complex<T>(std::min(res.min.real(), v.real()), std::min(res.min.imag(), v.imag()));
+        res.max = std::complex<T>(std::max(res.max.real(), v.real()), std::max(res.max.imag(), v.imag()));
+    }
+    const auto r = std::complex<T>(core.radius, core.radius);
+    res.min -= r;
+    res.max += r;
+    return res;
+}
+
+/**
+ * Returns the pairs (i, j), i < j, of boxes that overlap, sorted.
+ *
+ * The boxes are sorted by their lower x bound and swept, so that only boxes overlapping in x are compared.
+ */
+template<typename T>
+std::vector<std::pair<std::size_t, std::size_t>>
+sweep_and_prune(const Aabb<T>* boxes, std::size_t count)
+{
+    std::vector<std::size_t> order(count);
+    for(std::size_t i = 0; i < count; i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(),
+        [boxes](std::size_t i, std::size_t j){ return boxes[i].min.real() < boxes[j].min.real(); });
+
+    std::vector<std::pair<std::size_t, std::size_t>> res;
+    std::vector<std::size_t> active;
+    for(auto i : order)
+    {
+        const auto& box = boxes[i];
+        auto last = std::remove_if(active.begin(), active.end(),
+            [&](std::size_t j){ return boxes[j].max.real() < box.min.real(); });
+        active.erase(last, active.end());
+
+        for(auto j : active)
+        {
+            const auto& other = boxes[j];
+            if(other.min.imag() <= box.max.imag() && box.min.imag() <= other.max.imag())
+                res.push_back(std::make_pair(std::min(i, j), std::max(i, j)));
+        }
+        active.push_back(i);
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+/**
+ * Returns the pairs (i, j), i < j, of posed shapes that overlap or touch, sorted.
+ * Candidates come from sweep_and_prune over their bounding boxes and are confirmed with overlap().
+ */
+template<typename S, typename T>
+std::vector<std::pair<std::size_t, std::size_t>>
+overlapping_pairs(const S* shapes, const DualComplex<T>* poses, std::size_t count)
+{
+    std::vector<Aabb<T>> boxes;
+    boxes.reserve(count);
+    for(std::size_t i = 0; i < count; i++)
+        boxes.push_back(aabb(shapes[i], poses[i]));
+
+    auto res = sweep_and_prune(boxes.data(), count);
+    res.erase(
+        std::remove_if(res.begin(), res.end(),
+            [&](const std::pair<std::size_t, std::size_t>& p)
+            {
+                return !overlap(shapes[p.first], poses[p.first], shapes[p.second], poses[p.second]);
+            }),
+        res.end());
+    return res;
+}
+
+}   // namespace dcn
@@ -4,6 +4,8 @@
  */
 #pragma once
 
+#include "dualcomplex_instrument.h"
+
 namespace dcn
 {
 
@@ -57,6 +59,7 @@ template<typename T>
 DualComplex<T>
 normalize(const DualComplex<T>& dc)
 {
+    DUALCOMPLEX_INSTRUMENT("normalize", 1);
     return dc / norm(dc);
 }
 
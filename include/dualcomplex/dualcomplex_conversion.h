@@ -5,6 +5,7 @@
 #pragma once
 
 #include <Eigen/Core>
+#include "dualcomplex_instrument.h"
 
 namespace dcn
 {
@@ -16,6 +17,8 @@ template<typename T>
 Eigen::Matrix<T, 3, 3>
 convert_to_matrix(const DualComplex<T>& dc)
 {
+    DUALCOMPLEX_INSTRUMENT("convert_to_matrix", 1);
+
     Eigen::Matrix<T, 3, 3> m;
 
     const auto r_squared = dc.real() * dc.real();
@@ -0,0 +1,212 @@
+/**
+ * @file dualcomplex/dualcomplex_deskew.h
+ * @brief This file provides motion compensation of scanned points for dual complex types.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <vector>
+#include "dualcomplex_pose_interpolant.h"
+#include "dualcomplex_instrument.h"
+
+namespace dcn
+{
+
+namespace detail
+{
+
+/**
+ * Largest |angle * (a - a0)| over which a run of points shares the rotation at a0,
+ * small enough that the series in deskew() is accurate to double precision.
+ */
+constexpr double deskew_series_range = 1.0 / 256.0;
+
+/**
+ * Number of points transformed together. Runs are padded to whole chunks so that the loops have a fixed trip count.
+ */
+constexpr std::size_t deskew_chunk = 16;
+
+/**
+ * Interpolation between two consecutive poses of a track, pre-expanded for evaluation at many parameters.
+ *
+ * The pose at parameter a is start * pow(diff, a) with the shortest-path difference diff,
+ * and maps a point p to rotation * (e^{i angle a} * (p + a * twist)) + translation.
+ */
+template<typename T>
+struct DeskewSegment
+{
+    T rr, ri;   // Rotation of inverse(reference) * start.
+    T tr, ti;   // Translation of inverse(reference) * start.
+    T ur, ui;   // Twist.
+    T angle;
+
+    DeskewSegment(const DualComplex<T>& reference, const DualComplex<T>& p0, const DualComplex<T>& p1)
+    {
+        const auto diff = shortest_difference(p0, p1);
+        const auto half = std::arg(diff.real());
+        const auto twist = static_cast<T>(2) * std::conj(diff.real()) * diff.dual();
+        angle = static_cast<T>(2) * half;
+        ur = twist.real();
+        ui = twist.imag();
+
+        const auto base = transformation_difference(reference, p0);
+        const auto rotation = base.real() * base.real();
+        const auto translation = static_cast<T>(2) * base.real() * base.dual();
+        rr = rotation.real();
+        ri = rotation.imag();
+        tr = translation.real();
+        ti = translation.imag();
+    }
+};
+
+}   // namespace detail
+
+/**
+ * Moves every point, measured in the sensor frame at its own time, into the sensor frame at the reference pose.
+ *
+ * The sensor pose at a time is interpolated as slerp_shortestpath between the bracketing track poses,
+ * and times outside the track are clamped to its ends.
+ * track_times must be strictly increasing and out may alias points.
+ * Each point time is located from the segment of the previous one, so sorted scans cost amortized O(1) per point
+ * and out-of-order times O(log(track_size)).
+ */
+template<typename T>
+void
+deskew(
+    const T* track_times,
+    const DualComplex<T>* track_poses,
+    std::size_t track_size,
+    const DualComplex<T>& reference,
+    const T* times,
+    const std::complex<T>* points,
+    std::size_t count,
+    std::complex<T>* out)
+{
+    assert(track_size >= 2);
+    DUALCOMPLEX_INSTRUMENT("deskew", count);
+
+    std::vector<detail::DeskewSegment<T>> segments;
+    segments.reserve(track_size - 1);
+    for(std::size_t s = 0; s + 1 < track_size; s++)
+        segments.emplace_back(reference, track_poses[s], track_poses[s + 1]);
+
+    const auto range = static_cast<T>(detail::deskew_series_range);
+    const auto last = track_size - 2;
+
+    constexpr std::size_t block = 256;
+    constexpr std::size_t chunk = detail::deskew_chunk;
+    T parameter[block + chunk];
+    T px[block + chunk];
+    T py[block + chunk];
+    T x[block + chunk];
+    T y[block + chunk];
+    std::size_t run_start[block + 1];
+    std::size_t run_segment[block];
+
+    std::size_t cursor = 0;
+    for(std::size_t base = 0; base < count; base += block)
+    {
+        const auto n = std::min(block, count - base);
+
+        // Locates the segment and the parameter within it, splits the block into runs of points
+        // in one segment whose rotations are within the series range of the first one,
+        // and copies the points into separate x and y arrays.
+        std::size_t runs = 0;
+        T anchor = static_cast<T>(0);
+        for(std::size_t k = 0; k < n; k++)
+        {
+            const auto time = times[base + k];
+            const auto previous = cursor;
+            cursor = detail::find_segment(track_times, last, cursor, time);
+
+            const auto t0 = track_times[cursor];
+            const auto a = std::min(std::max((time - t0) / (track_times[cursor + 1] - t0), static_cast<T>(0)), static_cast<T>(1));
+            parameter[k] = a;
+            px[k] = points[base + k].real();
+            py[k] = points[base + k].imag();
+            if(k == 0 || cursor != previous || !(std::abs(segments[cursor].angle * (a - anchor)) <= range))
+            {
+                run_start[runs] = k;
+                run_segment[runs] = cursor;
+                runs++;
+                anchor = a;
+            }
+        }
+        run_start[runs] = n;
+        std::fill(parameter + n, parameter + n + chunk, static_cast<T>(0));
+        std::fill(px + n, px + n + chunk, static_cast<T>(0));
+        std::fill(py + n, py + n + chunk, static_cast<T>(0));
+
+        for(std::size_t r = 0; r < runs; r++)
+        {
+            // Everything but the parameter is constant over the run; the rotation at its first parameter a0
+            // is folded into the segment rotation, leaving e^{i angle (a - a0)} to the series.
+            const auto& s = segments[run_segment[r]];
+            const auto begin = run_start[r];
+            const auto end = run_start[r + 1];
+            const auto a0 = parameter[begin];
+            const auto rotation = std::complex<T>(s.rr, s.ri) * std::polar(static_cast<T>(1), s.angle * a0);
+            const auto rr = rotation.real();
+            const auto ri = rotation.imag();
+            const auto angle = s.angle;
+            const auto ur = s.ur;
+            const auto ui = s.ui;
+            const auto tr = s.tr;
+            const auto ti = s.ti;
+
+            // Transforms whole chunks from the start of the run. Results past its end are garbage
+            // that the next run overwrites, or fall into the padding past the block.
+            for(auto k0 = begin; k0 < end; k0 += chunk)
+            {
+                for(std::size_t j = 0; j < chunk; j++)
+                {
+                    const auto k = k0 + j;
+                    const auto a = parameter[k];
+                    // |d| <= deskew_series_range, so the series is accurate to double precision.
+                    const auto d = angle * (a - a0);
+                    const auto d2 = d * d;
+                    const auto c = static_cast<T>(1) - d2 * (static_cast<T>(0.5) - d2 * static_cast<T>(1.0 / 24.0));
+                    const auto sn = d * (static_cast<T>(1) - d2 * (static_cast<T>(1.0 / 6.0) - d2 * static_cast<T>(1.0 / 120.0)));
+
+                    const auto qx = px[k] + a * ur;
+                    const auto qy = py[k] + a * ui;
+                    const auto wx = c * qx - sn * qy;
+                    const auto wy = c * qy + sn * qx;
+                    x[k] = rr * wx - ri * wy + tr;
+                    y[k] = rr * wy + ri * wx + ti;
+                }
+            }
+        }
+
+        for(std::size_t k = 0; k < n; k++)
+            out[base + k] = std::complex<T>(x[k], y[k]);
+    }
+}
+
+/**
+ * Moves every point, measured in the sensor frame at its own time, into the sensor frame at the reference pose,
+ * where the sensor moves from start at start_time to end at end_time.
+ */
+template<typename T>
+void
+deskew(
+    const DualComplex<T>& start,
+    T start_time,
+    const DualComplex<T>& end,
+    T end_time,
+    const DualComplex<T>& reference,
+    const T* times,
+    const std::complex<T>* points,
+    std::size_t count,
+    std::complex<T>* out)
+{
+    const T track_times[2] = { start_time, end_time };
+    const DualComplex<T> track_poses[2] = { start, end };
+    deskew(track_times, track_poses, 2, reference, times, points, count, out);
+}
+
+}   // namespace dcn
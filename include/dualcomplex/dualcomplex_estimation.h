@@ -0,0 +1,140 @@
+/**
+ * @file dualcomplex/dualcomplex_estimation.h
+ * @brief This file provides pose estimation from point correspondences for dual complex types.
+ */
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include "dualcomplex_transform.h"
+
+namespace dcn
+{
+
+/**
+ * Streaming weighted least-squares fit of a transformation to point correspondences.
+ *
+ * Keeps the total weight, the weighted centroids and the centred cross-covariance,
+ * sum of w * conj(src - src_centroid) * (dst - dst_centroid), updated incrementally so that
+ * the result stays accurate far from the origin. Accumulators can be merged for parallel reduction.
+ */
+template<typename T>
+class PoseFitAccumulator
+{
+public:
+    using value_type = T;
+
+/* Constructors */
+    PoseFitAccumulator()
+        : weight_(static_cast<T>(0)),
+          src_centroid_(static_cast<T>(0), static_cast<T>(0)),
+          dst_centroid_(static_cast<T>(0), static_cast<T>(0)),
+          covariance_(static_cast<T>(0), static_cast<T>(0))
+    {}
+
+/* Accessors */
+    T weight() const noexcept { return weight_; }
+    const std::complex<T>& src_centroid() const noexcept { return src_centroid_; }
+    const std::complex<T>& dst_centroid() const noexcept { return dst_centroid_; }
+    const std::complex<T>& covariance() const noexcept { return covariance_; }
+
+/* Modifiers */
+    /**
+     * Adds a correspondence, src is mapped onto dst.
+     */
+    void add(const std::complex<T>& src, const std::complex<T>& dst, T weight = static_cast<T>(1))
+    {
+        weight_ += weight;
+        if(weight_ == static_cast<T>(0))
+            return;
+
+        const auto ratio = weight / weight_;
+        const auto ds = src - src_centroid_;
+        src_centroid_ += ratio * ds;
+        dst_centroid_ += ratio * (dst - dst_centroid_);
+        covariance_ += weight * std::conj(ds) * (dst - dst_centroid_);
+    }
+
+    /**
+     * Adds a range of correspondences in a single pass.
+     */
+    void add(const std::complex<T>* src, const std::complex<T>* dst, const T* weights, std::size_t count)
+    {
+        for(std::size_t i = 0; i < count; i++)
+            add(src[i], dst[i], weights[i]);
+    }
+
+    void add(const std::complex<T>* src, const std::complex<T>* dst, std::size_t count)
+    {
+        for(std::size_t i = 0; i < count; i++)
+            add(src[i], dst[i]);
+    }
+
+    /**
+     * Merges the statistics of another accumulator into this one.
+     */
+    PoseFitAccumulator& operator += (const PoseFitAccumulator& rhs)
+    {
+        if(rhs.weight_ == static_cast<T>(0))
+            return *this;
+        if(weight_ == static_cast<T>(0))
+            return *this = rhs;
+
+        const auto total = weight_ + rhs.weight_;
+        const auto ds = rhs.src_centroid_ - src_centroid_;
+        const auto dd = rhs.dst_centroid_ - dst_centroid_;
+        covariance_ += rhs.covariance_ + (weight_ * rhs.weight_ / total) * std::conj(ds) * dd;
+        src_centroid_ += (rhs.weight_ / total) * ds;
+        dst_centroid_ += (rhs.weight_ / total) * dd;
+        weight_ = total;
+        return *this;
+    }
+
+    void reset()
+    {
+        *this = PoseFitAccumulator();
+    }
+
+/* Operations */
+    /**
+     * Returns the unit dual complex number that minimizes the weighted squared distances.
+     */
+    DualComplex<T> estimate() const
+    {
+        const auto angle = std::arg(covariance_);
+        const auto d = dst_centroid_ - std::polar(static_cast<T>(1), angle) * src_centroid_;
+        return translation(d) * rotation(angle);
+    }
+
+private:
+    T weight_;
+    std::complex<T> src_centroid_;
+    std::complex<T> dst_centroid_;
+    std::complex<T> covariance_;
+};
+
+template<typename T>
+PoseFitAccumulator<T>
+operator + (const PoseFitAccumulator<T>& lhs, const PoseFitAccumulator<T>& rhs)
+{
+    PoseFitAccumulator<T> temp(lhs);
+    return temp += rhs;
+}
+
+/**
+ * Returns the transformation that minimizes the weighted squared distances from transformed src to dst.
+ */
+template<typename T>
+DualComplex<T>
+weighted_procrustes(
+    const std::complex<T>* src,
+    const std::complex<T>* dst,
+    const T* weights,
+    std::size_t count)
+{
+    PoseFitAccumulator<T> acc;
+    acc.add(src, dst, weights, count);
+    return acc.estimate();
+}
+
+}   // namespace dcn
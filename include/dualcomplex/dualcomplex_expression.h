@@ -0,0 +1,321 @@
+/**
+ * @file dualcomplex/dualcomplex_expression.h
+ * @brief This file provides lazily evaluated arithmetic over structure-of-arrays dual complex buffers.
+ *
+ * Expressions built from lazy() operands are not evaluated until they are assigned to a DualComplexSoA
+ * or reduced with sum(), so that a whole expression runs as a single pass over memory
+ * without intermediate arrays.
+ *
+ *     DualComplexSoA<float> res = (1.0f - t) * lazy(a) + t * lazy(b);
+ */
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "dualcomplex_soa.h"
+
+namespace dcn
+{
+
+/**
+ * Base of all element-wise expressions, E must provide value_type, size() and operator [].
+ */
+template<typename E>
+class SoAExpression
+{
+public:
+    const E& derived() const noexcept { return static_cast<const E&>(*this); }
+};
+
+/**
+ * Reference to the elements of a DualComplexSoA.
+ */
+template<typename T>
+class SoARef
+    : public SoAExpression<SoARef<T>>
+{
+public:
+    using value_type = T;
+
+    template<typename A>
+    explicit SoARef(const DualComplexSoA<T, A>& soa)
+        : rr_(soa.real_real()), ri_(soa.real_imag()), dr_(soa.dual_real()), di_(soa.dual_imag()),
+          size_(soa.size())
+    {}
+
+    std::size_t size() const noexcept { return size_; }
+
+    DualComplex<T> operator [] (std::size_t i) const
+    {
+        return DualComplex<T>(rr_[i], ri_[i], dr_[i], di_[i]);
+    }
+
+private:
+    const T* rr_;
+    const T* ri_;
+    const T* dr_;
+    const T* di_;
+    std::size_t size_;
+};
+
+/**
+ * Reference to an array of scalars, used as per-element weights.
+ */
+template<typename T>
+class ScalarArrayRef
+{
+public:
+    using value_type = T;
+
+    ScalarArrayRef(const T* data, std::size_t size)
+        : data_(data), size_(size)
+    {}
+
+    std::size_t size() const noexcept { return size_; }
+    T operator [] (std::size_t i) const { return data_[i]; }
+
+private:
+    const T* data_;
+    std::size_t size_;
+};
+
+/**
+ * The same dual complex number at every element.
+ */
+template<typename T>
+class SoAConstant
+    : public SoAExpression<SoAConstant<T>>
+{
+public:
+    using value_type = T;
+
+    SoAConstant(const DualComplex<T>& value, std::size_t size)
+        : value_(value), size_(size)
+    {}
+
+    std::size_t size() const noexcept { return size_; }
+    DualComplex<T> operator [] (std::size_t) const { return value_; }
+
+private:
+    DualComplex<T> value_;
+    std::size_t size_;
+};
+
+namespace detail
+{
+
+struct SoAPlus
+{
+    template<typename T>
+    static DualComplex<T> apply(const DualComplex<T>& lhs, const DualComplex<T>& rhs) { return lhs + rhs; }
+};
+
+struct SoAMinus
+{
+    template<typename T>
+    static DualComplex<T> apply(const DualComplex<T>& lhs, const DualComplex<T>& rhs) { return lhs - rhs; }
+};
+
+struct SoAMultiplies
+{
+    template<typename T>
+    static DualComplex<T> apply(const DualComplex<T>& lhs, const DualComplex<T>& rhs) { return lhs * rhs; }
+};
+
+}   // namespace detail
+
+template<typename L, typename R, typename Op>
+class SoABinary
+    : public SoAExpression<SoABinary<L, R, Op>>
+{
+public:
+    using value_type = typename L::value_type;
+
+    SoABinary(const L& lhs, const R& rhs)
+        : lhs_(lhs), rhs_(rhs)
+    {
+        assert(lhs.size() == rhs.size());
+    }
+
+    std::size_t size() const noexcept { return lhs_.size(); }
+
+    DualComplex<value_type> operator [] (std::size_t i) const
+    {
+        return Op::apply(lhs_[i], rhs_[i]);
+    }
+
+private:
+    L lhs_;
+    R rhs_;
+};
+
+template<typename E>
+class SoANegate
+    : public SoAExpression<SoANegate<E>>
+{
+public:
+    using value_type = typename E::value_type;
+
+    explicit SoANegate(const E& expr)
+        : expr_(expr)
+    {}
+
+    std::size_t size() const noexcept { return expr_.size(); }
+    DualComplex<value_type> operator [] (std::size_t i) const { return -expr_[i]; }
+
+private:
+    E expr_;
+};
+
+/**
+ * Expression multiplied by a scalar, either one value or one per element.
+ */
+template<typename E, typename S>
+class SoAScaled
+    : public SoAExpression<SoAScaled<E, S>>
+{
+public:
+    using value_type = typename E::value_type;
+
+    SoAScaled(const E& expr, const S& scale)
+        : expr_(expr), scale_(scale)
+    {}
+
+    std::size_t size() const noexcept { return expr_.size(); }
+    DualComplex<value_type> operator [] (std::size_t i) const { return expr_[i] * scale(i); }
+
+private:
+    template<typename U = S>
+    typename std::enable_if<std::is_arithmetic<U>::value, value_type>::type
+    scale(std::size_t) const { return scale_; }
+
+    template<typename U = S>
+    typename std::enable_if<!std::is_arithmetic<U>::value, value_type>::type
+    scale(std::size_t i) const { return scale_[i]; }
+
+    E expr_;
+    S scale_;
+};
+
+/* Terminals */
+
+template<typename T, typename A>
+SoARef<T>
+lazy(const DualComplexSoA<T, A>& soa)
+{
+    return SoARef<T>(soa);
+}
+
+template<typename T, typename A>
+ScalarArrayRef<T>
+lazy(const std::vector<T, A>& values)
+{
+    return ScalarArrayRef<T>(values.data(), values.size());
+}
+
+/* Unary operators */
+
+template<typename E>
+SoANegate<E>
+operator - (const SoAExpression<E>& expr)
+{
+    return SoANegate<E>(expr.derived());
+}
+
+/* Binary operators */
+
+template<typename L, typename R>
+SoABinary<L, R, detail::SoAPlus>
+operator + (const SoAExpression<L>& lhs, const SoAExpression<R>& rhs)
+{
+    return SoABinary<L, R, detail::SoAPlus>(lhs.derived(), rhs.derived());
+}
+
+template<typename L, typename R>
+SoABinary<L, R, detail::SoAMinus>
+operator - (const SoAExpression<L>& lhs, const SoAExpression<R>& rhs)
+{
+    return SoABinary<L, R, detail::SoAMinus>(lhs.derived(), rhs.derived());
+}
+
+/**
+ * Element-wise dual complex product.
+ */
+template<typename L, typename R>
+SoABinary<L, R, detail::SoAMultiplies>
+operator * (const SoAExpression<L>& lhs, const SoAExpression<R>& rhs)
+{
+    return SoABinary<L, R, detail::SoAMultiplies>(lhs.derived(), rhs.derived());
+}
+
+/**
+ * Product of every element with a dual complex number.
+ */
+template<typename E>
+SoABinary<SoAConstant<typename E::value_type>, E, detail::SoAMultiplies>
+operator * (const DualComplex<typename E::value_type>& lhs, const SoAExpression<E>& rhs)
+{
+    using C = SoAConstant<typename E::value_type>;
+    return SoABinary<C, E, detail::SoAMultiplies>(C(lhs, rhs.derived().size()), rhs.derived());
+}
+
+template<typename E>
+SoABinary<E, SoAConstant<typename E::value_type>, detail::SoAMultiplies>
+operator * (const SoAExpression<E>& lhs, const DualComplex<typename E::value_type>& rhs)
+{
+    using C = SoAConstant<typename E::value_type>;
+    return SoABinary<E, C, detail::SoAMultiplies>(lhs.derived(), C(rhs, lhs.derived().size()));
+}
+
+template<typename E>
+SoAScaled<E, typename E::value_type>
+operator * (typename E::value_type lhs, const SoAExpression<E>& rhs)
+{
+    return SoAScaled<E, typename E::value_type>(rhs.derived(), lhs);
+}
+
+template<typename E>
+SoAScaled<E, typename E::value_type>
+operator * (const SoAExpression<E>& lhs, typename E::value_type rhs)
+{
+    return SoAScaled<E, typename E::value_type>(lhs.derived(), rhs);
+}
+
+template<typename E>
+SoAScaled<E, ScalarArrayRef<typename E::value_type>>
+operator * (const ScalarArrayRef<typename E::value_type>& lhs, const SoAExpression<E>& rhs)
+{
+    assert(lhs.size() == rhs.derived().size());
+    return SoAScaled<E, ScalarArrayRef<typename E::value_type>>(rhs.derived(), lhs);
+}
+
+template<typename E>
+SoAScaled<E, ScalarArrayRef<typename E::value_type>>
+operator * (const SoAExpression<E>& lhs, const ScalarArrayRef<typename E::value_type>& rhs)
+{
+    assert(lhs.derived().size() == rhs.size());
+    return SoAScaled<E, ScalarArrayRef<typename E::value_type>>(lhs.derived(), rhs);
+}
+
+/* Reductions */
+
+/**
+ * Returns the sum of all elements, evaluated in a single pass.
+ */
+template<typename E>
+DualComplex<typename E::value_type>
+sum(const SoAExpression<E>& expr)
+{
+    using T = typename E::value_type;
+    constexpr auto zero = static_cast<T>(0);
+
+    const auto& e = expr.derived();
+    auto res = DualComplex<T>(zero, zero, zero, zero);
+    for(std::size_t i = 0; i < e.size(); i++)
+        res += e[i];
+    return res;
+}
+
+}   // namespace dcn
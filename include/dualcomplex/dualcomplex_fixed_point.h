@@ -0,0 +1,729 @@
+/**
+ * @file dualcomplex/dualcomplex_fixed_point.h
+ * @brief This file provides fixed-point scalar types for dual complex numbers.
+ *
+ * All operations, including sin, cos and sqrt, use integer arithmetic only,
+ * so results are bit-identical on every platform, as required by lockstep simulation.
+ * Negative values rely on arithmetic right shifts, as on all supported compilers.
+ *
+ *     using DC = DualComplex<Q16_16>;
+ *     const auto p = translation(std::complex<Q16_16>(Q16_16(1), Q16_16(2))) * rotation(Q16_16(0.5));
+ */
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include "dualcomplex_base.h"
+
+namespace dcn
+{
+
+namespace detail
+{
+
+/**
+ * Two's complement 128-bit integer, just enough for fixed-point products, quotients and square roots.
+ */
+struct Int128
+{
+    std::uint64_t hi;
+    std::uint64_t lo;
+};
+
+inline Int128
+make_int128(std::int64_t x)
+{
+    Int128 res;
+    res.hi = (x < 0) ? ~static_cast<std::uint64_t>(0) : 0;
+    res.lo = static_cast<std::uint64_t>(x);
+    return res;
+}
+
+inline Int128
+make_uint128(std::uint64_t x)
+{
+    Int128 res;
+    res.hi = 0;
+    res.lo = x;
+    return res;
+}
+
+inline Int128
+operator + (const Int128& lhs, const Int128& rhs)
+{
+    Int128 res;
+    res.lo = lhs.lo + rhs.lo;
+    res.hi = lhs.hi + rhs.hi + ((res.lo < lhs.lo) ? 1u : 0u);
+    return res;
+}
+
+inline Int128
+operator - (const Int128& x)
+{
+    Int128 res;
+    res.lo = ~x.lo + 1u;
+    res.hi = ~x.hi + ((res.lo == 0) ? 1u : 0u);
+    return res;
+}
+
+inline Int128
+operator - (const Int128& lhs, const Int128& rhs)
+{
+    return lhs + (-rhs);
+}
+
+/**
+ * Unsigned comparison.
+ */
+inline bool
+less_unsigned(const Int128& lhs, const Int128& rhs)
+{
+    return (lhs.hi < rhs.hi) || (lhs.hi == rhs.hi && lhs.lo < rhs.lo);
+}
+
+inline Int128
+shift_left(const Int128& x, int n)
+{
+    if(n == 0)
+        return x;
+
+    Int128 res;
+    if(n >= 64)
+    {
+        res.hi = x.lo << (n - 64);
+        res.lo = 0;
+    }
+    else
+    {
+        res.hi = (x.hi << n) | (x.lo >> (64 - n));
+        res.lo = x.lo << n;
+    }
+    return res;
+}
+
+/**
+ * Arithmetic right shift.
+ */
+inline Int128
+shift_right(const Int128& x, int n)
+{
+    if(n == 0)
+        return x;
+
+    const auto fill = ((x.hi >> 63) != 0) ? ~static_cast<std::uint64_t>(0) : 0;
+    Int128 res;
+    if(n >= 64)
+    {
+        res.lo = (n == 64) ? x.hi : ((x.hi >> (n - 64)) | (fill << (128 - n)));
+        res.hi = fill;
+    }
+    else
+    {
+        res.lo = (x.lo >> n) | (x.hi << (64 - n));
+        res.hi = (x.hi >> n) | (fill << (64 - n));
+    }
+    return res;
+}
+
+inline std::int64_t
+low64(const Int128& x)
+{
+    return static_cast<std::int64_t>(x.lo);
+}
+
+inline Int128
+multiply_unsigned(std::uint64_t a, std::uint64_t b)
+{
+    const std::uint64_t mask = 0xffffffffu;
+    const auto a0 = a & mask;
+    const auto a1 = a >> 32;
+    const auto b0 = b & mask;
+    const auto b1 = b >> 32;
+
+    const auto p00 = a0 * b0;
+    const auto p01 = a0 * b1;
+    const auto p10 = a1 * b0;
+    const auto p11 = a1 * b1;
+    const auto mid = (p00 >> 32) + (p01 & mask) + (p10 & mask);
+
+    Int128 res;
+    res.lo = (p00 & mask) | (mid << 32);
+    res.hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    return res;
+}
+
+/**
+ * The sign helpers work on the sign bits in unsigned arithmetic, so that no signed comparison
+ * is left for the optimizer to rewrite under -Wstrict-overflow.
+ */
+inline std::uint64_t
+magnitude(std::int64_t x)
+{
+    const auto u = static_cast<std::uint64_t>(x);
+    const auto mask = 0u - (u >> 63);
+    return (u ^ mask) - mask;
+}
+
+inline bool
+opposite_signs(std::int64_t a, std::int64_t b)
+{
+    return ((static_cast<std::uint64_t>(a) ^ static_cast<std::uint64_t>(b)) >> 63) != 0;
+}
+
+inline Int128
+multiply(std::int64_t a, std::int64_t b)
+{
+    const auto res = multiply_unsigned(magnitude(a), magnitude(b));
+    return opposite_signs(a, b) ? -res : res;
+}
+
+/**
+ * Quotient of a non-negative dividend by a positive divisor, truncated to 64 bits.
+ */
+inline std::uint64_t
+divide_unsigned(const Int128& dividend, std::uint64_t divisor)
+{
+    std::uint64_t quotient = 0;
+    std::uint64_t remainder = 0;
+    for(int i = 127; i >= 0; i--)
+    {
+        const auto carry = remainder >> 63;
+        const auto bit = (i >= 64) ? (dividend.hi >> (i - 64)) & 1u : (dividend.lo >> i) & 1u;
+        remainder = (remainder << 1) | bit;
+        quotient <<= 1;
+        if(carry != 0 || remainder >= divisor)
+        {
+            remainder -= divisor;
+            quotient |= 1u;
+        }
+    }
+    return quotient;
+}
+
+/**
+ * Integer square root of a non-negative value.
+ */
+inline std::uint64_t
+sqrt_unsigned(Int128 x)
+{
+    auto res = make_uint128(0);
+    auto bit = shift_left(make_uint128(1), 126);
+    while(less_unsigned(x, bit))
+        bit = shift_right(bit, 2);
+
+    while(bit.hi != 0 || bit.lo != 0)
+    {
+        const auto trial = res + bit;
+        if(!less_unsigned(x, trial))
+        {
+            x = x - trial;
+            res = shift_right(res, 1) + bit;
+        }
+        else
+        {
+            res = shift_right(res, 1);
+        }
+        bit = shift_right(bit, 2);
+    }
+    return res.lo;
+}
+
+inline std::int32_t
+fixed_multiply(std::int32_t a, std::int32_t b, int fraction_bits)
+{
+    const auto p = static_cast<std::int64_t>(a) * b + (static_cast<std::int64_t>(1) << (fraction_bits - 1));
+    return static_cast<std::int32_t>(p >> fraction_bits);
+}
+
+inline std::int64_t
+fixed_multiply(std::int64_t a, std::int64_t b, int fraction_bits)
+{
+    const auto p = multiply(a, b) + make_int128(static_cast<std::int64_t>(1) << (fraction_bits - 1));
+    return low64(shift_right(p, fraction_bits));
+}
+
+/**
+ * The value an overflowing result saturates to.
+ */
+template<typename Rep>
+Rep
+saturated(bool negative)
+{
+    return negative ? std::numeric_limits<Rep>::min() : std::numeric_limits<Rep>::max();
+}
+
+/**
+ * Sum and difference, saturated on overflow. The operands are added as unsigned integers,
+ * and the result overflowed if its sign differs from the signs the operands imply.
+ */
+template<typename Rep>
+Rep
+saturating_add(Rep a, Rep b)
+{
+    using U = typename std::make_unsigned<Rep>::type;
+    constexpr int sign_bit = 8 * sizeof(Rep) - 1;
+    const auto res = static_cast<U>(static_cast<U>(a) + static_cast<U>(b));
+    if((((static_cast<U>(a) ^ res) & (static_cast<U>(b) ^ res)) >> sign_bit) != 0)
+        return saturated<Rep>(a < 0);
+    return static_cast<Rep>(res);
+}
+
+template<typename Rep>
+Rep
+saturating_subtract(Rep a, Rep b)
+{
+    using U = typename std::make_unsigned<Rep>::type;
+    constexpr int sign_bit = 8 * sizeof(Rep) - 1;
+    const auto res = static_cast<U>(static_cast<U>(a) - static_cast<U>(b));
+    if((((static_cast<U>(a) ^ static_cast<U>(b)) & (static_cast<U>(a) ^ res)) >> sign_bit) != 0)
+        return saturated<Rep>(a < 0);
+    return static_cast<Rep>(res);
+}
+
+template<typename Rep>
+Rep
+saturating_negate(Rep a)
+{
+    return (a == std::numeric_limits<Rep>::min()) ? std::numeric_limits<Rep>::max() : static_cast<Rep>(-a);
+}
+
+/**
+ * Quotient truncated toward zero. Quotients out of range, and division by zero, saturate
+ * toward the sign of the exact result, or of the dividend for a zero divisor.
+ */
+inline std::int32_t
+fixed_divide(std::int32_t a, std::int32_t b, int fraction_bits)
+{
+    if(b == 0)
+        return (a == 0) ? 0 : saturated<std::int32_t>(a < 0);
+    const auto q = static_cast<std::int64_t>(a) * (static_cast<std::int64_t>(1) << fraction_bits) / b;
+    if(q > std::numeric_limits<std::int32_t>::max() || q < std::numeric_limits<std::int32_t>::min())
+        return saturated<std::int32_t>(q < 0);
+    return static_cast<std::int32_t>(q);
+}
+
+inline std::int64_t
+fixed_divide(std::int64_t a, std::int64_t b, int fraction_bits)
+{
+    if(b == 0)
+        return (a == 0) ? 0 : saturated<std::int64_t>(a < 0);
+
+    const auto negative = opposite_signs(a, b);
+    const auto dividend = shift_left(make_uint128(magnitude(a)), fraction_bits);
+    const auto divisor = magnitude(b);
+    // The quotient has more than 64 bits exactly when the high half of the dividend is not below the divisor.
+    if(dividend.hi >= divisor)
+        return saturated<std::int64_t>(negative);
+
+    // |min| = 2^63 is representable only for a negative result.
+    constexpr auto limit = static_cast<std::uint64_t>(1) << 63;
+    const auto q = divide_unsigned(dividend, divisor);
+    if(q > limit || (q == limit && !negative))
+        return saturated<std::int64_t>(negative);
+    return negative ? static_cast<std::int64_t>(0u - q) : static_cast<std::int64_t>(q);
+}
+
+/**
+ * Clamps an integer of any type to [lower, upper], where lower < 0 <= upper.
+ */
+template<typename U>
+typename std::enable_if<std::is_signed<U>::value, std::int64_t>::type
+clamp_integer(U x, std::int64_t lower, std::int64_t upper)
+{
+    return (x < lower) ? lower : (x > upper) ? upper : static_cast<std::int64_t>(x);
+}
+
+template<typename U>
+typename std::enable_if<std::is_unsigned<U>::value, std::int64_t>::type
+clamp_integer(U x, std::int64_t, std::int64_t upper)
+{
+    return (x > static_cast<std::uint64_t>(upper)) ? upper : static_cast<std::int64_t>(x);
+}
+
+template<typename Rep>
+Rep
+fixed_sqrt(Rep a, int fraction_bits)
+{
+    if(a <= 0)
+        return 0;
+    return static_cast<Rep>(sqrt_unsigned(shift_left(make_uint128(static_cast<std::uint64_t>(a)), fraction_bits)));
+}
+
+/**
+ * sin(j * pi / 512) for j in [0, 256], in Q2.61.
+ */
+inline const std::int64_t*
+sine_table()
+{
+    static const std::int64_t table[257] = {
+    0ll, 14148386723594466ll, 28296240768425490ll, 42443029475784682ll,
+    56588220227073008ll, 70731280463853576ll, 84871677707902161ll, 99008879581254711ll,
+    113142353826251070ll, 127271568325574189ll, 141395991122284031ll, 155515090439845456ll,
+    169628334702149306ll, 183735192553525942ll, 197835132878750488ll, 211927624823039019ll,
+    226012137812034940ll, 240088141571784815ll, 254155106148702879ll, 268212501929523490ll,
+    282259799661240775ll, 296296470471034697ll, 310321985886182827ll, 324335817853957038ll,
+    338337438761504393ll, 352326321455711470ll, 366301939263051383ll, 380263766009412734ll,
+    394211276039909781ll, 408143944238673040ll, 422061246048619602ll, 435962657491202414ll,
+    449847655186137774ll, 463715716371110297ll, 477566318921454632ll, 491398941369813148ll,
+    505213062925768895ll, 519008163495453065ll, 532783723701126231ll, 546539224900732628ll,
+    560274149207426732ll, 573987979509071405ll, 587680199487706880ll, 601350293638989834ll,
+    614997747291601840ll, 628622046626626450ll, 642222678696894185ll, 655799131446294707ll,
+    669350893729055444ll, 682877455328985937ll, 696378306978687192ll, 709852940378725310ll,
+    723300848216768674ll, 736721524186687968ll, 750114463007618322ll, 763479160442982849ll,
+    776815113319476863ll, 790121819546012076ll, 803398778132620041ll, 816645489209314137ll,
+    829861454044909399ll, 843046175065799461ll, 856199155874689921ll, 869319901269287418ll,
+    882407917260943721ll, 895462711093254121ll, 908483791260609431ll, 921470667526700893ll,
+    934422850942977303ll, 947339853867053640ll, 960221189981070533ll, 973066374310003850ll,
+    985874923239923734ll, 998646354536202394ll, 1011380187361669968ll, 1024075942294717768ll,
+    1036733141347348235ll, 1049351307983170915ll, 1061929967135343787ll, 1074468645224459256ll,
+    1086966870176374159ll, 1099424171439983080ll, 1111840080004934340ll, 1124214128419287969ll,
+    1136545850807115006ll, 1148834782886037467ll, 1161080461984708313ll, 1173282427060230766ll,
+    1185440218715516311ll, 1197553379216580736ll, 1209621452509777565ll, 1221643984238968209ll,
+    1233620521762628228ll, 1245550614170889022ll, 1257433812302514336ll, 1269269668761810925ll,
+    1281057737935472749ll, 1292797576009358063ll, 1304488740985198769ll, 1316130792697241401ll,
+    1327723292828819113ll, 1339265804928854059ll, 1350757894428289527ll, 1362199128656451220ll,
+    1373589076857337057ll, 1384927310205834901ll, 1396213401823867576ll, 1407446926796464588ll,
+    1418627462187759932ll, 1429754587056915391ll, 1440827882473968718ll, 1451846931535606111ll,
+    1462811319380858392ll, 1473720633206720285ll, 1484574462283692214ll, 1495372397971244041ll,
+    1506114033733200148ll, 1516798965153045293ll, 1527426789949150668ll, 1537997107989919569ll,
+    1548509521308852131ll, 1558963634119528534ll, 1569359052830510146ll, 1579695386060158012ll,
+    1589972244651368155ll, 1600189241686223121ll, 1610345992500559217ll, 1620442114698448902ll,
+    1630477228166597777ll, 1640450955088655634ll, 1650362919959441033ll, 1660212749599078853ll,
+    1670000073167050307ll, 1679724522176154880ll, 1689385730506383660ll, 1698983334418703549ll,
+    1708516972568751838ll, 1717986286020440611ll, 1727390918259470489ll, 1736730515206753193ll,
+    1746004725231742418ll, 1755213199165672529ll, 1764355590314704565ll, 1773431554472979063ll,
+    1782440749935575221ll, 1791382837511375890ll, 1800257480535837929ll, 1809064344883667436ll,
+    1817803098981399375ll, 1826473413819881130ll, 1835074962966659515ll, 1843607422578270767ll,
+    1852070471412433076ll, 1860463790840141169ll, 1868787064857662518ll, 1877039980098434696ll,
+    1885222225844863454ll, 1893333494040021063ll, 1901373479299244483ll, 1909341878921632922ll,
+    1917238392901444355ll, 1925062723939390570ll, 1932814577453830318ll, 1940493661591860145ll,
+    1948099687240302491ll, 1955632368036590635ll, 1963091420379550085ll, 1970476563440076002ll,
+    1977787519171706257ll, 1985024012321089723ll, 1992185770438349408ll, 1999272523887340039ll,
+    2006284005855799711ll, 2013219952365395218ll, 2020080102281660686ll, 2026864197323829139ll,
+    2033571982074556626ll, 2040203203989538538ll, 2046757613407017758ll, 2053234963557184283ll,
+    2059635010571465975ll, 2065957513491710065ll, 2072202234279255101ll, 2078368937823892961ll,
+    2084457391952720625ll, 2090467367438881350ll, 2096398638010194935ll, 2102250980357676738ll,
+    2108024174143945132ll, 2113718002011517088ll, 2119332249590991555ll, 2124866705509120352ll,
+    2130321161396766249ll, 2135695411896747946ll, 2140989254671571658ll, 2146202490411049005ll,
+    2151334922839800929ll, 2156386358724647349ll, 2161356607881882284ll, 2166245483184434160ll,
+    2171052800568911040ll, 2175778379042530504ll, 2180422040689933930ll, 2184983610679884900ll,
+    2189462917271851503ll, 2193859791822472264ll, 2198174068791905478ll, 2202405585750061683ll,
+    2206554183382719070ll, 2210619705497521563ll, 2214601999029859385ll, 2218500914048631843ll,
+    2222316303761892157ll, 2226048024522374089ll, 2229695935832900185ll, 2233259900351671410ll,
+    2236739783897437994ll, 2240135455454551278ll, 2243446787177896376ll, 2246673654397705477ll,
+    2249815935624251589ll, 2252873512552422556ll, 2255846270066175182ll, 2258734096242869284ll,
+    2261536882357481515ll, 2264254522886698801ll, 2266886915512891233ll, 2269433961127964271ll,
+    2271895563837090101ll, 2274271630962318030ll, 2276562073046063751ll, 2278766803854477374ll,
+    2280885740380690081ll, 2282918802847939289ll, 2284865914712572195ll, 2286727002666927611ll,
+    2288501996642095944ll, 2290190829810557260ll, 2291793438588697300ll, 2293309762639201365ll,
+    2294739744873325982ll, 2296083331453048267ll, 2297340471793092890ll, 2298511118562836589ll,
+    2299595227688090133ll, 2300592758352757699ll, 2301503673000373568ll, 2302327937335516109ll,
+    2303065520325098980ll, 2303716394199539505ll, 2304280534453804189ll, 2304757919848331311ll,
+    2305148532409830587ll, 2305452357431959851ll, 2305669383475878743ll, 2305799602370679373ll,
+    2305843009213693952ll,
+    };
+    return table;
+}
+
+/**
+ * Returns sin(x) and cos(x) in Q2.61 for x given in Q2.61 extended to 128 bits.
+ */
+inline void
+sincos_q61(const Int128& x, std::int64_t& s, std::int64_t& c)
+{
+    const std::int64_t one = static_cast<std::int64_t>(1) << 61;
+    const std::int64_t step = 14148475504056881ll;    // pi / 512
+
+    auto mul = [](std::int64_t a, std::int64_t b)
+    {
+        return low64(shift_right(multiply(a, b) + make_int128(static_cast<std::int64_t>(1) << 60), 61));
+    };
+
+    // Split x into a multiple of the table step and a small remainder.
+    const auto negative = (x.hi >> 63) != 0;
+    const auto n_magnitude = divide_unsigned((negative ? -x : x) + make_int128(step / 2), static_cast<std::uint64_t>(step));
+    const auto n = negative ? -static_cast<std::int64_t>(n_magnitude) : static_cast<std::int64_t>(n_magnitude);
+    const auto delta = low64(x - multiply(n, step));
+
+    const auto k = static_cast<std::uint64_t>(n) & 1023u;
+    const auto j = static_cast<std::size_t>(k & 255u);
+    const auto table = sine_table();
+    std::int64_t sk, ck;
+    switch(k >> 8)
+    {
+    case 0: sk = table[j]; ck = table[256 - j]; break;
+    case 1: sk = table[256 - j]; ck = -table[j]; break;
+    case 2: sk = -table[j]; ck = -table[256 - j]; break;
+    default: sk = -table[256 - j]; ck = table[j]; break;
+    }
+
+    // Taylor series of the remainder, |delta| <= pi / 1024.
+    const auto d2 = mul(delta, delta);
+    const auto d3 = mul(d2, delta);
+    const auto sd = delta - d3 / 6 + mul(d3, d2) / 120;
+    const auto cd = one - d2 / 2 + mul(d2, d2) / 24;
+
+    s = mul(sk, cd) + mul(ck, sd);
+    c = mul(ck, cd) - mul(sk, sd);
+}
+
+}   // namespace detail
+
+/**
+ * Signed fixed-point number with FractionBits fractional bits stored in Rep, std::int32_t or std::int64_t.
+ */
+template<typename Rep, int FractionBits>
+class FixedPoint
+{
+    static_assert(std::is_same<Rep, std::int32_t>::value || std::is_same<Rep, std::int64_t>::value,
+        "Template parameter Rep must be std::int32_t or std::int64_t.");
+    static_assert(FractionBits > 0 && FractionBits <= 32 && FractionBits < static_cast<int>(8 * sizeof(Rep)) - 1,
+        "Template parameter FractionBits is out of range.");
+public:
+    using rep_type = Rep;
+    static constexpr int fraction_bits = FractionBits;
+
+/* Constructors */
+    constexpr FixedPoint()
+        : raw_(0)
+    {}
+
+    /**
+     * Constructs a fixed-point number from an integer or, rounded to nearest, a floating point number.
+     */
+    template<typename U>
+    explicit FixedPoint(U x, typename std::enable_if<std::is_arithmetic<U>::value>::type* = nullptr)
+        : raw_(from_arithmetic(x))
+    {}
+
+    static FixedPoint from_raw(Rep raw)
+    {
+        FixedPoint res;
+        res.raw_ = raw;
+        return res;
+    }
+
+/* Accessors */
+    Rep raw() const noexcept { return raw_; }
+
+    template<typename U, typename = typename std::enable_if<std::is_floating_point<U>::value>::type>
+    explicit operator U() const
+    {
+        return std::ldexp(static_cast<U>(raw_), -FractionBits);
+    }
+
+/* Assignment operators */
+    FixedPoint& operator += (const FixedPoint& rhs) { raw_ = detail::saturating_add(raw_, rhs.raw_); return *this; }
+    FixedPoint& operator -= (const FixedPoint& rhs) { raw_ = detail::saturating_subtract(raw_, rhs.raw_); return *this; }
+
+    FixedPoint& operator *= (const FixedPoint& rhs)
+    {
+        raw_ = detail::fixed_multiply(raw_, rhs.raw_, FractionBits);
+        return *this;
+    }
+
+    FixedPoint& operator /= (const FixedPoint& rhs)
+    {
+        raw_ = detail::fixed_divide(raw_, rhs.raw_, FractionBits);
+        return *this;
+    }
+
+private:
+    /**
+     * Integers outside the representable range saturate.
+     */
+    template<typename U>
+    static typename std::enable_if<std::is_integral<U>::value, Rep>::type
+    from_arithmetic(U x)
+    {
+        constexpr auto upper = static_cast<std::int64_t>(std::numeric_limits<Rep>::max() >> FractionBits);
+        const auto clamped = detail::clamp_integer(x, -upper - 1, upper + 1);
+        if(clamped > upper)
+            return std::numeric_limits<Rep>::max();
+        return static_cast<Rep>(clamped * (static_cast<std::int64_t>(1) << FractionBits));
+    }
+
+    /**
+     * Floating point numbers outside the representable range saturate, and NaN becomes zero.
+     */
+    template<typename U>
+    static typename std::enable_if<std::is_floating_point<U>::value, Rep>::type
+    from_arithmetic(U x)
+    {
+        const auto scaled = std::floor(std::ldexp(static_cast<double>(x), FractionBits) + 0.5);
+        const auto limit = std::ldexp(1.0, 8 * static_cast<int>(sizeof(Rep)) - 1);
+        if(std::isnan(scaled))
+            return 0;
+        if(scaled >= limit)
+            return std::numeric_limits<Rep>::max();
+        if(scaled < -limit)
+            return std::numeric_limits<Rep>::min();
+        return static_cast<Rep>(scaled);
+    }
+
+    Rep raw_;
+};
+
+template<typename Rep, int FractionBits>
+constexpr int FixedPoint<Rep, FractionBits>::fraction_bits;
+
+using Q16_16 = FixedPoint<std::int32_t, 16>;
+using Q32_32 = FixedPoint<std::int64_t, 32>;
+
+template<typename Rep, int FractionBits>
+struct is_dual_complex_scalar<FixedPoint<Rep, FractionBits>>
+    : std::true_type
+{};
+
+/* Unary operators */
+
+template<typename Rep, int FractionBits>
+FixedPoint<Rep, FractionBits>
+operator + (const FixedPoint<Rep, FractionBits>& x)
+{
+    return x;
+}
+
+template<typename Rep, int FractionBits>
+FixedPoint<Rep, FractionBits>
+operator - (const FixedPoint<Rep, FractionBits>& x)
+{
+    return FixedPoint<Rep, FractionBits>::from_raw(detail::saturating_negate(x.raw()));
+}
+
+/* Binary operators */
+
+template<typename Rep, int FractionBits>
+FixedPoint<Rep, FractionBits>
+operator + (const FixedPoint<Rep, FractionBits>& lhs, const FixedPoint<Rep, FractionBits>& rhs)
+{
+    auto temp = lhs;
+    return temp += rhs;
+}
+
+template<typename Rep, int FractionBits>
+FixedPoint<Rep, FractionBits>
+operator - (const FixedPoint<Rep, FractionBits>& lhs, const FixedPoint<Rep, FractionBits>& rhs)
+{
+    auto temp = lhs;
+    return temp -= rhs;
+}
+
+template<typename Rep, int FractionBits>
+FixedPoint<Rep, FractionBits>
+operator * (const FixedPoint<Rep, FractionBits>& lhs, const FixedPoint<Rep, FractionBits>& rhs)
+{
+    auto temp = lhs;
+    return temp *= rhs;
+}
+
+template<typename Rep, int FractionBits>
+FixedPoint<Rep, FractionBits>
+operator / (const FixedPoint<Rep, FractionBits>& lhs, const FixedPoint<Rep, FractionBits>& rhs)
+{
+    auto temp = lhs;
+    return temp /= rhs;
+}
+
+/* Relational operators */
+
+template<typename Rep, int FractionBits>
+bool
+operator == (const FixedPoint<Rep, FractionBits>& lhs, const FixedPoint<Rep, FractionBits>& rhs)
+{
+    return lhs.raw() == rhs.raw();
+}
+
+template<typename Rep, int FractionBits>
+bool
+operator != (const FixedPoint<Rep, FractionBits>& lhs, const FixedPoint<Rep, FractionBits>& rhs)
+{
+    return lhs.raw() != rhs.raw();
+}
+
+template<typename Rep, int FractionBits>
+bool
+operator < (const FixedPoint<Rep, FractionBits>& lhs, const FixedPoint<Rep, FractionBits>& rhs)
+{
+    return lhs.raw() < rhs.raw();
+}
+
+template<typename Rep, int FractionBits>
+bool
+operator <= (const FixedPoint<Rep, FractionBits>& lhs, const FixedPoint<Rep, FractionBits>& rhs)
+{
+    return lhs.raw() <= rhs.raw();
+}
+
+template<typename Rep, int FractionBits>
+bool
+operator > (const FixedPoint<Rep, FractionBits>& lhs, const FixedPoint<Rep, FractionBits>& rhs)
+{
+    return lhs.raw() > rhs.raw();
+}
+
+template<typename Rep, int FractionBits>
+bool
+operator >= (const FixedPoint<Rep, FractionBits>& lhs, const FixedPoint<Rep, FractionBits>& rhs)
+{
+    return lhs.raw() >= rhs.raw();
+}
+
+/* Mathematical functions, found by argument-dependent lookup */
+
+template<typename Rep, int FractionBits>
+FixedPoint<Rep, FractionBits>
+abs(const FixedPoint<Rep, FractionBits>& x)
+{
+    return (x.raw() < 0) ? -x : x;
+}
+
+/**
+ * Square root rounded down, zero for negative arguments.
+ */
+template<typename Rep, int FractionBits>
+FixedPoint<Rep, FractionBits>
+sqrt(const FixedPoint<Rep, FractionBits>& x)
+{
+    return FixedPoint<Rep, FractionBits>::from_raw(detail::fixed_sqrt(x.raw(), FractionBits));
+}
+
+/**
+ * Computes sin(x) and cos(x) from a quarter-wave lookup table refined with a short Taylor series.
+ */
+template<typename Rep, int FractionBits>
+void
+sincos(const FixedPoint<Rep, FractionBits>& x, FixedPoint<Rep, FractionBits>& s, FixedPoint<Rep, FractionBits>& c)
+{
+    std::int64_t sq, cq;
+    detail::sincos_q61(detail::shift_left(detail::make_int128(x.raw()), 61 - FractionBits), sq, cq);
+
+    const auto shift = 61 - FractionBits;
+    const auto half = static_cast<std::int64_t>(1) << (shift - 1);
+    s = FixedPoint<Rep, FractionBits>::from_raw(static_cast<Rep>((sq + half) >> shift));
+    c = FixedPoint<Rep, FractionBits>::from_raw(static_cast<Rep>((cq + half) >> shift));
+}
+
+template<typename Rep, int FractionBits>
+FixedPoint<Rep, FractionBits>
+sin(const FixedPoint<Rep, FractionBits>& x)
+{
+    FixedPoint<Rep, FractionBits> s, c;
+    sincos(x, s, c);
+    return s;
+}
+
+template<typename Rep, int FractionBits>
+FixedPoint<Rep, FractionBits>
+cos(const FixedPoint<Rep, FractionBits>& x)
+{
+    FixedPoint<Rep, FractionBits> s, c;
+    sincos(x, s, c);
+    return c;
+}
+
+}   // namespace dcn
@@ -0,0 +1,197 @@
+/**
+ * @file dualcomplex/dualcomplex_hash.h
+ * @brief This file provides hashing and ordering for dual complex types.
+ */
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "dualcomplex_canonical.h"
+
+namespace dcn
+{
+
+namespace detail
+{
+
+inline std::size_t
+hash_combine(std::size_t seed, std::size_t value)
+{
+    return seed ^ (value + static_cast<std::size_t>(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2));
+}
+
+/**
+ * Hashes the components of the canonical form, with -0 and +0 hashing alike.
+ */
+template<typename T>
+std::size_t
+hash_canonical(const DualComplex<T>& dc)
+{
+    const std::hash<T> hasher;
+    const auto c = canonicalize(dc);
+    auto seed = hasher(c.real().real() + static_cast<T>(0));
+    seed = hash_combine(seed, hasher(c.real().imag() + static_cast<T>(0)));
+    seed = hash_combine(seed, hasher(c.dual().real() + static_cast<T>(0)));
+    seed = hash_combine(seed, hasher(c.dual().imag() + static_cast<T>(0)));
+    return seed;
+}
+
+/**
+ * Returns the index of the cell of width cell_size that contains x.
+ */
+template<typename T>
+std::int64_t
+quantize(T x, T cell_size)
+{
+    return static_cast<std::int64_t>(std::floor(x / cell_size));
+}
+
+}   // namespace detail
+
+/**
+ * Strict weak ordering of transformations, lexicographic on the canonical components.
+ * dc and -dc are equivalent.
+ */
+template<typename T>
+bool
+canonical_less(const DualComplex<T>& lhs, const DualComplex<T>& rhs)
+{
+    const auto a = canonicalize(lhs);
+    const auto b = canonicalize(rhs);
+    if(a.real().real() != b.real().real())
+        return a.real().real() < b.real().real();
+    if(a.real().imag() != b.real().imag())
+        return a.real().imag() < b.real().imag();
+    if(a.dual().real() != b.dual().real())
+        return a.dual().real() < b.dual().real();
+    return a.dual().imag() < b.dual().imag();
+}
+
+template<typename T>
+bool
+operator < (const CanonicalDualComplex<T>& lhs, const CanonicalDualComplex<T>& rhs)
+{
+    return canonical_less(lhs.value(), rhs.value());
+}
+
+/**
+ * Ordering functor for ordered containers keyed by transformations.
+ */
+template<typename T>
+struct CanonicalLess
+{
+    bool operator () (const DualComplex<T>& lhs, const DualComplex<T>& rhs) const
+    {
+        return canonical_less(lhs, rhs);
+    }
+};
+
+/**
+ * Exact equality functor consistent with std::hash<DualComplex<T>>, where dc and -dc are equal,
+ * for std::unordered_map<DualComplex<T>, V, std::hash<DualComplex<T>>, CanonicalEqual<T>>.
+ */
+template<typename T>
+struct CanonicalEqual
+{
+    bool operator () (const DualComplex<T>& lhs, const DualComplex<T>& rhs) const
+    {
+        const auto a = canonicalize(lhs);
+        const auto b = canonicalize(rhs);
+        return a.real() == b.real() && a.dual() == b.dual();
+    }
+};
+
+/**
+ * Hash functor that maps the canonical components to cells of width cell_size.
+ * Transformations in the same cell hash identically and compare equal with QuantizedEqual.
+ *
+ * Two values closer than cell_size may still fall in neighbouring cells,
+ * and values near a half turn may be canonicalized to opposite signs.
+ */
+template<typename T>
+class QuantizedHash
+{
+public:
+    explicit QuantizedHash(T cell_size)
+        : cell_size_(cell_size)
+    {
+        assert(cell_size > static_cast<T>(0));
+    }
+
+    T cell_size() const noexcept { return cell_size_; }
+
+    std::size_t operator () (const DualComplex<T>& dc) const
+    {
+        const std::hash<std::int64_t> hasher;
+        const auto c = canonicalize(dc);
+        auto seed = hasher(detail::quantize(c.real().real(), cell_size_));
+        seed = detail::hash_combine(seed, hasher(detail::quantize(c.real().imag(), cell_size_)));
+        seed = detail::hash_combine(seed, hasher(detail::quantize(c.dual().real(), cell_size_)));
+        seed = detail::hash_combine(seed, hasher(detail::quantize(c.dual().imag(), cell_size_)));
+        return seed;
+    }
+
+private:
+    T cell_size_;
+};
+
+/**
+ * Equality functor consistent with QuantizedHash, true if both values fall in the same cell.
+ */
+template<typename T>
+class QuantizedEqual
+{
+public:
+    explicit QuantizedEqual(T cell_size)
+        : cell_size_(cell_size)
+    {
+        assert(cell_size > static_cast<T>(0));
+    }
+
+    T cell_size() const noexcept { return cell_size_; }
+
+    bool operator () (const DualComplex<T>& lhs, const DualComplex<T>& rhs) const
+    {
+        const auto a = canonicalize(lhs);
+        const auto b = canonicalize(rhs);
+        return detail::quantize(a.real().real(), cell_size_) == detail::quantize(b.real().real(), cell_size_)
+            && detail::quantize(a.real().imag(), cell_size_) == detail::quantize(b.real().imag(), cell_size_)
+            && detail::quantize(a.dual().real(), cell_size_) == detail::quantize(b.dual().real(), cell_size_)
+            && detail::quantize(a.dual().imag(), cell_size_) == detail::quantize(b.dual().imag(), cell_size_);
+    }
+
+private:
+    T cell_size_;
+};
+
+}   // namespace dcn
+
+namespace std
+{
+
+/**
+ * Exact hash of a transformation, the same for dc and -dc.
+ * DualComplex has no operator ==, so unordered containers need dcn::CanonicalEqual as their key equality.
+ */
+template<typename T>
+struct hash<dcn::DualComplex<T>>
+{
+    std::size_t operator () (const dcn::DualComplex<T>& dc) const
+    {
+        return dcn::detail::hash_canonical(dc);
+    }
+};
+
+template<typename T>
+struct hash<dcn::CanonicalDualComplex<T>>
+{
+    std::size_t operator () (const dcn::CanonicalDualComplex<T>& dc) const
+    {
+        return dcn::detail::hash_canonical(dc.value());
+    }
+};
+
+}   // namespace std
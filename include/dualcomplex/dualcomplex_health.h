@@ -0,0 +1,150 @@
+/**
+ * @file dualcomplex/dualcomplex_health.h
+ * @brief This file provides bulk numerical health checks for dual complex types.
+ */
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "dualcomplex_instrument.h"
+#include "dualcomplex_soa.h"
+
+namespace dcn
+{
+
+/**
+ * Summary of the numerical state of a buffer of transformations.
+ */
+template<typename T>
+struct HealthReport
+{
+    T max_norm_deviation = static_cast<T>(0);       // max |norm(dc) - 1| over finite elements.
+    std::size_t max_norm_deviation_index = 0;
+    std::size_t drifted = 0;                        // Finite elements with |norm(dc) - 1| > tolerance.
+    std::size_t non_finite = 0;                     // Elements with a NaN or infinite component.
+    std::vector<std::size_t> non_finite_indices;    // The first of them, up to max_indices.
+};
+
+namespace detail
+{
+
+/**
+ * Scans the elements in blocks; the per-element work is branch-free,
+ * and only the per-block results are inspected with branches.
+ */
+template<typename T, typename Load>
+HealthReport<T>
+check_health(std::size_t count, T tolerance, std::size_t max_indices, Load load)
+{
+    DUALCOMPLEX_INSTRUMENT("check_health", count);
+
+    constexpr std::size_t block = 256;
+    T deviation[block];
+    unsigned char finite[block];
+
+    HealthReport<T> report;
+    for(std::size_t base = 0; base < count; base += block)
+    {
+        const auto n = (count - base < block) ? count - base : block;
+
+        std::size_t block_non_finite = 0;
+        for(std::size_t j = 0; j < n; j++)
+        {
+            T rr, ri, dr, di;
+            load(base + j, rr, ri, dr, di);
+            const auto zero = static_cast<T>(0);
+            const bool ok = (rr * zero == zero) & (ri * zero == zero) & (dr * zero == zero) & (di * zero == zero);
+            finite[j] = static_cast<unsigned char>(ok);
+            block_non_finite += ok ? 0u : 1u;
+            const auto d = std::abs(std::sqrt(rr * rr + ri * ri) - static_cast<T>(1));
+            deviation[j] = ok ? d : zero;
+        }
+
+        for(std::size_t j = 0; j < n; j++)
+        {
+            report.drifted += (deviation[j] > tolerance) ? 1u : 0u;
+            if(deviation[j] > report.max_norm_deviation)
+            {
+                report.max_norm_deviation = deviation[j];
+                report.max_norm_deviation_index = base + j;
+            }
+        }
+
+        if(block_non_finite > 0)
+        {
+            report.non_finite += block_non_finite;
+            for(std::size_t j = 0; j < n && report.non_finite_indices.size() < max_indices; j++)
+            {
+                if(!finite[j])
+                    report.non_finite_indices.push_back(base + j);
+            }
+        }
+    }
+    return report;
+}
+
+}   // namespace detail
+
+/**
+ * Checks how far the elements have drifted from unit norm and whether any of them is not finite.
+ *
+ * Unlike dual quaternions, dual complex numbers have no orthogonality constraint between
+ * the real and the dual part, so the norm of the real part is the only invariant to monitor.
+ */
+template<typename T>
+HealthReport<T>
+check_health(const DualComplex<T>* dcs, std::size_t count, T tolerance, std::size_t max_indices = 16)
+{
+    return detail::check_health(count, tolerance, max_indices,
+        [dcs](std::size_t i, T& rr, T& ri, T& dr, T& di)
+        {
+            rr = dcs[i].real().real();
+            ri = dcs[i].real().imag();
+            dr = dcs[i].dual().real();
+            di = dcs[i].dual().imag();
+        });
+}
+
+template<typename T, typename A>
+HealthReport<T>
+check_health(const DualComplexSoA<T, A>& dcs, T tolerance, std::size_t max_indices = 16)
+{
+    const auto a = dcs.real_real();
+    const auto b = dcs.real_imag();
+    const auto c = dcs.dual_real();
+    const auto d = dcs.dual_imag();
+    return detail::check_health(dcs.size(), tolerance, max_indices,
+        [=](std::size_t i, T& rr, T& ri, T& dr, T& di)
+        {
+            rr = a[i];
+            ri = b[i];
+            dr = c[i];
+            di = d[i];
+        });
+}
+
+/**
+ * Normalizes the finite elements whose norm deviates from one by more than tolerance,
+ * and returns how many were changed.
+ */
+template<typename T>
+std::size_t
+renormalize_drifted(DualComplex<T>* dcs, std::size_t count, T tolerance)
+{
+    std::size_t res = 0;
+    for(std::size_t i = 0; i < count; i++)
+    {
+        const auto n = std::abs(dcs[i].real());
+        const auto& dual = dcs[i].dual();
+        if(std::abs(n - static_cast<T>(1)) > tolerance && std::isfinite(n) && n > static_cast<T>(0)
+            && std::isfinite(dual.real()) && std::isfinite(dual.imag()))
+        {
+            dcs[i] /= n;
+            res++;
+        }
+    }
+    return res;
+}
+
+}   // namespace dcn
@@ -0,0 +1,169 @@
+/**
+ * @file dualcomplex/dualcomplex_hermite.h
+ * @brief This file provides cubic Hermite interpolation of timestamped poses and twists for dual complex types.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <vector>
+#include <Eigen/Core>
+#include "dualcomplex_common.h"
+#include "dualcomplex_exponential.h"
+#include "dualcomplex_pose_interpolant.h"
+#include "dualcomplex_jacobian.h"
+#include "dualcomplex_instrument.h"
+
+namespace dcn
+{
+
+namespace detail
+{
+
+/**
+ * Cubic in the tangent space of the first pose of a segment, X(s) = p0 * exp(hat(tau(s))) for s in [0, 1],
+ * with tau(s) = ((a s + b) s + c) s stored per component.
+ */
+template<typename T>
+struct HermiteSegment
+{
+    T r0r, r0i, d0r, d0i;   // p0
+    T a[3], b[3], c[3];
+
+    HermiteSegment(
+        const DualComplex<T>& p0,
+        const DualComplex<T>& p1,
+        const Eigen::Matrix<T, 3, 1>& v0,
+        const Eigen::Matrix<T, 3, 1>& v1,
+        T duration)
+        : r0r(p0.real().real()), r0i(p0.real().imag()), d0r(p0.dual().real()), d0i(p0.dual().imag())
+    {
+        const Eigen::Matrix<T, 3, 1> delta = vee(log(shortest_difference(p0, p1)));
+
+        // The body twist of X(s) is right_jacobian(tau) * tau'(s) / duration, and right_jacobian(0) is the identity.
+        const Eigen::Matrix<T, 3, 1> m0 = duration * v0;
+        const Eigen::Matrix<T, 3, 1> m1 = duration * (inverse_right_jacobian(delta) * v1);
+        for(int k = 0; k < 3; k++)
+        {
+            a[k] = m0(k) + m1(k) - static_cast<T>(2) * delta(k);
+            b[k] = static_cast<T>(3) * delta(k) - static_cast<T>(2) * m0(k) - m1(k);
+            c[k] = m0(k);
+        }
+    }
+
+    DualComplex<T> evaluate(T s) const
+    {
+        constexpr auto half = static_cast<T>(0.5);
+        const auto x = ((a[0] * s + b[0]) * s + c[0]) * s;
+        const auto y = ((a[1] * s + b[1]) * s + c[1]) * s;
+        const auto theta = ((a[2] * s + b[2]) * s + c[2]) * s;
+
+        // p0 * (e, e * (x + i y) / 2) with e = e^{i theta / 2}.
+        const auto er = std::cos(half * theta);
+        const auto ei = std::sin(half * theta);
+        const auto rr = r0r * er - r0i * ei;
+        const auto ri = r0r * ei + r0i * er;
+        return DualComplex<T>(
+            rr,
+            ri,
+            d0r * er + d0i * ei + half * (rr * x - ri * y),
+            d0i * er - d0r * ei + half * (rr * y + ri * x));
+    }
+};
+
+}   // namespace detail
+
+/**
+ * Piecewise cubic Hermite interpolation of unit poses with their body twists.
+ *
+ * Twists are ordered as (x, y, theta), like tangent vectors, and are body-frame rates,
+ * so that the pose after a short dt is pose * exp(hat(twist * dt)).
+ * Each segment interpolates in the tangent space of its first pose along the shortest rotation,
+ * and its coefficients are computed once on construction.
+ * The interpolant passes through every pose with the given twist.
+ */
+template<typename T>
+class HermiteSpline
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using vector_type = Eigen::Matrix<T, 3, 1>;
+
+/* Constructors */
+    /**
+     * Builds the spline through count >= 2 samples with strictly increasing times.
+     */
+    HermiteSpline(const T* times, const DualComplex<T>* poses, const vector_type* twists, size_type count)
+        : times_(times, times + count), last_(poses[count - 1])
+    {
+        assert(count >= 2);
+        segments_.reserve(count - 1);
+        inverse_durations_.reserve(count - 1);
+        for(size_type i = 0; i + 1 < count; i++)
+        {
+            const auto duration = times[i + 1] - times[i];
+            assert(duration > static_cast<T>(0));
+            segments_.emplace_back(poses[i], poses[i + 1], twists[i], twists[i + 1], duration);
+            inverse_durations_.push_back(static_cast<T>(1) / duration);
+        }
+    }
+
+/* Accessors */
+    size_type size() const noexcept { return times_.size(); }
+    T start_time() const noexcept { return times_.front(); }
+    T end_time() const noexcept { return times_.back(); }
+
+/* Operations */
+    /**
+     * Returns the pose at a time, clamped to the time range.
+     */
+    DualComplex<T> evaluate(T time) const
+    {
+        size_type cursor = 0;
+        return evaluate_from(time, cursor);
+    }
+
+    /**
+     * Evaluates the poses at many times, clamped to the time range.
+     * Each time is located from the segment of the previous one, so sorted times cost amortized O(1) each
+     * and out-of-order times O(log(size())).
+     */
+    void evaluate(const T* times, size_type count, DualComplex<T>* out) const
+    {
+        DUALCOMPLEX_INSTRUMENT("hermite_evaluate", count);
+
+        size_type cursor = 0;
+        for(size_type k = 0; k < count; k++)
+            out[k] = evaluate_from(times[k], cursor);
+    }
+
+private:
+    /**
+     * Returns the pose at a time, searching from the segment cursor and moving it to the segment found.
+     * Times at or after the end return the last pose itself, which the last segment only matches up to sign.
+     */
+    DualComplex<T> evaluate_from(T time, size_type& cursor) const
+    {
+        if(!(time < times_.back()))
+            return last_;
+        cursor = detail::find_segment(times_.data(), segments_.size() - 1, cursor, time);
+        return segments_[cursor].evaluate(parameter(cursor, time));
+    }
+
+    T parameter(size_type i, T time) const
+    {
+        const auto s = (time - times_[i]) * inverse_durations_[i];
+        return std::min(std::max(s, static_cast<T>(0)), static_cast<T>(1));
+    }
+
+    std::vector<T> times_;
+    std::vector<T> inverse_durations_;
+    std::vector<detail::HermiteSegment<T>> segments_;
+    DualComplex<T> last_;
+};
+
+}   // namespace dcn
@@ -0,0 +1,402 @@
+/**
+ * @file dualcomplex/dualcomplex_icp.h
+ * @brief This file provides 2D point-cloud registration for dual complex types.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <Eigen/Core>
+#include <Eigen/Cholesky>
+#include "dualcomplex_transform.h"
+#include "dualcomplex_estimation.h"
+
+namespace dcn
+{
+
+/**
+ * Static k-d tree over 2D points for nearest-neighbour queries.
+ */
+template<typename T>
+class PointKdTree
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+/* Constructors */
+    PointKdTree() = default;
+
+    explicit PointKdTree(std::vector<std::complex<T>> points)
+        : points_(std::move(points))
+    {
+        build();
+    }
+
+/* Accessors */
+    const std::vector<std::complex<T>>& points() const noexcept { return points_; }
+    size_type size() const noexcept { return points_.size(); }
+
+/* Operations */
+    /**
+     * Returns the index of the nearest point within sqrt(max_squared_distance), or npos.
+     */
+    size_type nearest(
+        const std::complex<T>& query,
+        T* squared_distance = nullptr,
+        T max_squared_distance = std::numeric_limits<T>::infinity()) const
+    {
+        auto best = npos;
+        auto best_sd = max_squared_distance;
+        nearest(0, index_.size(), query, best, best_sd);
+        if(squared_distance)
+            *squared_distance = best_sd;
+        return best;
+    }
+
+    /**
+     * Returns the indices of the k nearest points, closest first.
+     */
+    std::vector<size_type> nearest_k(const std::complex<T>& query, size_type k) const
+    {
+        std::vector<std::pair<T, size_type>> heap;
+        heap.reserve(k + 1);
+        if(k > 0)
+            nearest_k(0, index_.size(), query, k, heap);
+
+        std::sort_heap(heap.begin(), heap.end());
+        std::vector<size_type> res;
+        res.reserve(heap.size());
+        for(const auto& item : heap)
+            res.push_back(item.second);
+        return res;
+    }
+
+private:
+    static T coordinate(const std::complex<T>& p, unsigned char axis)
+    {
+        return (axis == 0) ? p.real() : p.imag();
+    }
+
+    void build()
+    {
+        index_.resize(points_.size());
+        axis_.resize(points_.size());
+        for(size_type i = 0; i < index_.size(); i++)
+            index_[i] = i;
+        build(0, index_.size());
+    }
+
+    void build(size_type lo, size_type hi)
+    {
+        if(hi - lo < 1)
+            return;
+
+        auto min = points_[index_[lo]];
+        auto max = min;
+        for(auto i = lo + 1; i < hi; i++)
+        {
+            const auto& p = points_[index_[i]];
+            min = std::complex<T>(std::min(min.real(), p.real()), std::min(min.imag(), p.imag()));
+            max = std::complex<T>(std::max(max.real(), p.real()), std::max(max.imag(), p.imag()));
+        }
+        const auto extent = max - min;
+        const unsigned char axis = (extent.real() >= extent.imag()) ? 0 : 1;
+
+        const auto mid = lo + (hi - lo) / 2;
+        using diff_type = typename std::vector<size_type>::difference_type;
+        std::nth_element(
+            index_.begin() + static_cast<diff_type>(lo),
+            index_.begin() + static_cast<diff_type>(mid),
+            index_.begin() + static_cast<diff_type>(hi),
+            [this, axis](size_type a, size_type b)
+            {
+                return coordinate(points_[a], axis) < coordinate(points_[b], axis);
+            });
+        axis_[mid] = axis;
+
+        build(lo, mid);
+        build(mid + 1, hi);
+    }
+
+    void nearest(size_type lo, size_type hi, const std::complex<T>& query, size_type& best, T& best_sd) const
+    {
+        if(hi <= lo)
+            return;
+
+        const auto mid = lo + (hi - lo) / 2;
+        const auto& p = points_[index_[mid]];
+        const auto sd = std::norm(p - query);
+        if(sd < best_sd)
+        {
+            best_sd = sd;
+            best = index_[mid];
+        }
+
+        const auto diff = coordinate(query, axis_[mid]) - coordinate(p, axis_[mid]);
+        if(diff < static_cast<T>(0))
+        {
+            nearest(lo, mid, query, best, best_sd);
+            if(diff * diff < best_sd)
+                nearest(mid + 1, hi, query, best, best_sd);
+        }
+        else
+        {
+            nearest(mid + 1, hi, query, best, best_sd);
+            if(diff * diff < best_sd)
+                nearest(lo, mid, query, best, best_sd);
+        }
+    }
+
+    void nearest_k(
+        size_type lo,
+        size_type hi,
+        const std::complex<T>& query,
+        size_type k,
+        std::vector<std::pair<T, size_type>>& heap) const
+    {
+        if(hi <= lo)
+            return;
+
+        const auto mid = lo + (hi - lo) / 2;
+        const auto& p = points_[index_[mid]];
+        const auto sd = std::norm(p - query);
+        if(heap.size() < k || sd < heap.front().first)
+        {
+            heap.emplace_back(sd, index_[mid]);
+            std::push_heap(heap.begin(), heap.end());
+            if(heap.size() > k)
+            {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.pop_back();
+            }
+        }
+
+        const auto diff = coordinate(query, axis_[mid]) - coordinate(p, axis_[mid]);
+        const auto near_lo = diff < static_cast<T>(0);
+        if(near_lo)
+            nearest_k(lo, mid, query, k, heap);
+        else
+            nearest_k(mid + 1, hi, query, k, heap);
+
+        if(heap.size() < k || diff * diff < heap.front().first)
+        {
+            if(near_lo)
+                nearest_k(mid + 1, hi, query, k, heap);
+            else
+                nearest_k(lo, mid, query, k, heap);
+        }
+    }
+
+    std::vector<std::complex<T>> points_;
+    std::vector<size_type> index_;
+    std::vector<unsigned char> axis_;
+};
+
+template<typename T>
+constexpr typename PointKdTree<T>::size_type PointKdTree<T>::npos;
+
+/**
+ * 2D iterative closest point registration against a fixed target point set.
+ */
+template<typename T>
+class IterativeClosestPoint
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    enum class Method
+    {
+        PointToPoint,
+        PointToLine
+    };
+
+    struct Options
+    {
+        Method method = Method::PointToPoint;
+        int max_iterations = 50;
+        T max_correspondence_distance = std::numeric_limits<T>::infinity();
+        T translation_tolerance = static_cast<T>(1e-6);
+        T rotation_tolerance = static_cast<T>(1e-6);
+    };
+
+    struct Result
+    {
+        DualComplex<T> transform;
+        int iterations = 0;
+        size_type correspondences = 0;
+        T rmse = static_cast<T>(0);
+        bool converged = false;
+    };
+
+/* Constructors */
+    explicit IterativeClosestPoint(std::vector<std::complex<T>> target)
+        : tree_(std::move(target))
+    {}
+
+/* Accessors */
+    const PointKdTree<T>& target() const noexcept { return tree_; }
+    const std::vector<std::complex<T>>& target_normals() const noexcept { return normals_; }
+
+/* Modifiers */
+    /**
+     * Sets unit normals of the target points, used by the point-to-line method.
+     */
+    void set_target_normals(std::vector<std::complex<T>> normals)
+    {
+        assert(normals.size() == tree_.size());
+        normals_ = std::move(normals);
+    }
+
+    /**
+     * Estimates target normals from the principal axes of the k nearest neighbours.
+     */
+    void estimate_target_normals(size_type k = 5);
+
+/* Operations */
+    /**
+     * Returns the transformation that aligns the source points to the target.
+     */
+    Result align(const std::vector<std::complex<T>>& source, const DualComplex<T>& initial, const Options& options) const;
+
+    Result align(const std::vector<std::complex<T>>& source, const DualComplex<T>& initial) const
+    {
+        return align(source, initial, Options());
+    }
+
+private:
+    DualComplex<T> point_to_line_step(
+        const std::vector<std::complex<T>>& src,
+        const std::vector<size_type>& matches) const;
+
+    PointKdTree<T> tree_;
+    std::vector<std::complex<T>> normals_;
+};
+
+template<typename T>
+void
+IterativeClosestPoint<T>::estimate_target_normals(size_type k)
+{
+    const auto& points = tree_.points();
+    normals_.resize(points.size());
+
+    for(size_type i = 0; i < points.size(); i++)
+    {
+        const auto neighbours = tree_.nearest_k(points[i], k);
+
+        auto mean = std::complex<T>(static_cast<T>(0), static_cast<T>(0));
+        for(auto j : neighbours)
+            mean += points[j];
+        mean /= static_cast<T>(neighbours.size());
+
+        // The doubled-angle sum of squares gives the principal direction of a 2x2 covariance.
+        auto sum = std::complex<T>(static_cast<T>(0), static_cast<T>(0));
+        for(auto j : neighbours)
+        {
+            const auto d = points[j] - mean;
+            sum += d * d;
+        }
+        const auto direction = std::polar(static_cast<T>(1), std::arg(sum) / static_cast<T>(2));
+        normals_[i] = std::complex<T>(-direction.imag(), direction.real());
+    }
+}
+
+template<typename T>
+DualComplex<T>
+IterativeClosestPoint<T>::point_to_line_step(
+    const std::vector<std::complex<T>>& src,
+    const std::vector<size_type>& matches) const
+{
+    // Linearized in the rotation angle: n . (s + theta * i * s + t - d) = 0
+    Eigen::Matrix<T, 3, 3> a = Eigen::Matrix<T, 3, 3>::Zero();
+    Eigen::Matrix<T, 3, 1> b = Eigen::Matrix<T, 3, 1>::Zero();
+
+    const auto& points = tree_.points();
+    for(size_type i = 0; i < src.size(); i++)
+    {
+        const auto m = matches[i];
+        if(m == PointKdTree<T>::npos)
+            continue;
+
+        const auto& s = src[i];
+        const auto& n = normals_[m];
+        const Eigen::Matrix<T, 3, 1> j(n.real(), n.imag(), n.imag() * s.real() - n.real() * s.imag());
+        const auto r = n.real() * (s.real() - points[m].real()) + n.imag() * (s.imag() - points[m].imag());
+        a += j * j.transpose();
+        b -= j * r;
+    }
+
+    const Eigen::Matrix<T, 3, 1> x = a.ldlt().solve(b);
+    return translation(std::complex<T>(x(0), x(1))) * rotation(x(2));
+}
+
+template<typename T>
+typename IterativeClosestPoint<T>::Result
+IterativeClosestPoint<T>::align(
+    const std::vector<std::complex<T>>& source,
+    const DualComplex<T>& initial,
+    const Options& options) const
+{
+    assert(options.method == Method::PointToPoint || normals_.size() == tree_.size());
+
+    Result result;
+    result.transform = initial;
+
+    const auto max_sd = options.max_correspondence_distance * options.max_correspondence_distance;
+    const auto& points = tree_.points();
+
+    std::vector<std::complex<T>> moved(source.size());
+    std::vector<size_type> matches(source.size());
+    PoseFitAccumulator<T> acc;
+
+    for(int iteration = 0; iteration < options.max_iterations; iteration++)
+    {
+        result.iterations = iteration + 1;
+
+        transform(result.transform, source.data(), source.size(), moved.data());
+
+        acc.reset();
+        size_type count = 0;
+        auto sum_sd = static_cast<T>(0);
+        for(size_type i = 0; i < moved.size(); i++)
+        {
+            auto sd = static_cast<T>(0);
+            matches[i] = tree_.nearest(moved[i], &sd, max_sd);
+            if(matches[i] == PointKdTree<T>::npos)
+                continue;
+            acc.add(moved[i], points[matches[i]]);
+            sum_sd += sd;
+            count++;
+        }
+
+        result.correspondences = count;
+        if(count < 3)
+            break;
+        result.rmse = std::sqrt(sum_sd / static_cast<T>(count));
+
+        const auto step = (options.method == Method::PointToPoint)
+            ? acc.estimate()
+            : point_to_line_step(moved, matches);
+        result.transform = normalize(step * result.transform);
+
+        const auto dt = std::abs(static_cast<T>(2) * step.real() * step.dual());
+        const auto da = std::abs(static_cast<T>(2) * std::arg(step.real()));
+        if(dt <= options.translation_tolerance && da <= options.rotation_tolerance)
+        {
+            result.converged = true;
+            break;
+        }
+    }
+    return result;
+}
+
+}   // namespace dcn
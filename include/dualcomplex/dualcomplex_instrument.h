@@ -0,0 +1,25 @@
+/**
+ * @file dualcomplex/dualcomplex_instrument.h
+ * @brief This file provides the DUALCOMPLEX_INSTRUMENT macro used by the library's hot paths.
+ *
+ * Without DUALCOMPLEX_ENABLE_INSTRUMENTATION the macro expands to nothing and this header includes nothing,
+ * so that headers can instrument their operations at no cost. The counters themselves are declared
+ * in dualcomplex_instrumentation.h.
+ */
+#pragma once
+
+#if defined(DUALCOMPLEX_ENABLE_INSTRUMENTATION)
+#include <cstdint>
+#include "dualcomplex_instrumentation.h"
+
+/**
+ * Times the rest of the enclosing scope as one call of the named operation over the given number of elements.
+ */
+#define DUALCOMPLEX_INSTRUMENT(name, elements) \
+    static ::dcn::InstrumentationCounter& dualcomplex_instrument_counter \
+        = ::dcn::InstrumentationRegistry::instance().counter(name); \
+    const ::dcn::ScopedTimer dualcomplex_instrument_timer( \
+        dualcomplex_instrument_counter, static_cast<std::uint64_t>(elements))
+#else
+#define DUALCOMPLEX_INSTRUMENT(name, elements) static_cast<void>(0)
+#endif
@@ -0,0 +1,217 @@
+/**
+ * @file dualcomplex/dualcomplex_instrumentation.h
+ * @brief This file provides opt-in performance counters for dual complex operations.
+ *
+ * Defining DUALCOMPLEX_ENABLE_INSTRUMENTATION, or configuring with the CMake option of the same name,
+ * makes the library's hot paths count calls, processed elements and elapsed time per operation.
+ * Without it DUALCOMPLEX_INSTRUMENT, defined in dualcomplex_instrument.h, expands to nothing and the library
+ * headers do not include this file. The macro must be defined the same way in every translation unit of a program.
+ *
+ * Counters are reported with InstrumentationRegistry::instance().report_text() or report_json().
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dcn
+{
+
+/**
+ * Cumulative statistics of one operation, updated concurrently.
+ */
+class InstrumentationCounter
+{
+public:
+/* Constructors */
+    explicit InstrumentationCounter(std::string name)
+        : name_(std::move(name)), calls_(0), elements_(0), nanoseconds_(0)
+    {}
+
+    InstrumentationCounter(const InstrumentationCounter&) = delete;
+    InstrumentationCounter& operator = (const InstrumentationCounter&) = delete;
+
+/* Accessors */
+    const std::string& name() const noexcept { return name_; }
+    std::uint64_t calls() const noexcept { return calls_.load(std::memory_order_relaxed); }
+    std::uint64_t elements() const noexcept { return elements_.load(std::memory_order_relaxed); }
+    std::uint64_t nanoseconds() const noexcept { return nanoseconds_.load(std::memory_order_relaxed); }
+
+/* Modifiers */
+    void add(std::uint64_t elements, std::uint64_t nanoseconds) noexcept
+    {
+        calls_.fetch_add(1, std::memory_order_relaxed);
+        elements_.fetch_add(elements, std::memory_order_relaxed);
+        nanoseconds_.fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+
+    void reset() noexcept
+    {
+        calls_.store(0, std::memory_order_relaxed);
+        elements_.store(0, std::memory_order_relaxed);
+        nanoseconds_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::string name_;
+    std::atomic<std::uint64_t> calls_;
+    std::atomic<std::uint64_t> elements_;
+    std::atomic<std::uint64_t> nanoseconds_;
+};
+
+/**
+ * Process-wide set of counters, keyed by operation name.
+ */
+class InstrumentationRegistry
+{
+public:
+    struct Record
+    {
+        std::string name;
+        std::uint64_t calls;
+        std::uint64_t elements;
+        std::uint64_t nanoseconds;
+    };
+
+    static InstrumentationRegistry& instance()
+    {
+        static InstrumentationRegistry registry;
+        return registry;
+    }
+
+    InstrumentationRegistry(const InstrumentationRegistry&) = delete;
+    InstrumentationRegistry& operator = (const InstrumentationRegistry&) = delete;
+
+/* Accessors */
+    /**
+     * Returns the counter of an operation, creating it on first use.
+     * The reference stays valid for the lifetime of the program.
+     */
+    InstrumentationCounter& counter(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for(auto& c : counters_)
+        {
+            if(c.name() == name)
+                return c;
+        }
+        counters_.emplace_back(name);
+        return counters_.back();
+    }
+
+    /**
+     * Returns the current values of all counters, in order of creation.
+     */
+    std::vector<Record> snapshot() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<Record> res;
+        res.reserve(counters_.size());
+        for(const auto& c : counters_)
+        {
+            const Record record = { c.name(), c.calls(), c.elements(), c.nanoseconds() };
+            res.push_back(record);
+        }
+        return res;
+    }
+
+/* Modifiers */
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for(auto& c : counters_)
+            c.reset();
+    }
+
+/* Operations */
+    /**
+     * Writes one line per operation that has been called.
+     */
+    void report_text(std::ostream& os) const
+    {
+        os << "operation calls elements nanoseconds ns/element\n";
+        for(const auto& r : snapshot())
+        {
+            if(r.calls == 0)
+                continue;
+
+            const auto per_element = (r.elements > 0)
+                ? static_cast<double>(r.nanoseconds) / static_cast<double>(r.elements)
+                : 0.0;
+            os << r.name << ' ' << r.calls << ' ' << r.elements << ' ' << r.nanoseconds << ' ' << per_element << '\n';
+        }
+    }
+
+    /**
+     * Writes a JSON object mapping each operation that has been called to its counters.
+     */
+    void report_json(std::ostream& os) const
+    {
+        os << '{';
+        auto first = true;
+        for(const auto& r : snapshot())
+        {
+            if(r.calls == 0)
+                continue;
+
+            if(!first)
+                os << ',';
+            first = false;
+
+            os << '"';
+            for(auto ch : r.name)
+            {
+                if(ch == '"' || ch == '\\')
+                    os << '\\';
+                os << ch;
+            }
+            os << "\":{\"calls\":" << r.calls
+               << ",\"elements\":" << r.elements
+               << ",\"nanoseconds\":" << r.nanoseconds << '}';
+        }
+        os << '}';
+    }
+
+private:
+    InstrumentationRegistry() = default;
+
+    mutable std::mutex mutex_;
+    std::deque<InstrumentationCounter> counters_;
+};
+
+/**
+ * Adds one call, the given number of elements and the lifetime of the timer to a counter.
+ */
+class ScopedTimer
+{
+public:
+    ScopedTimer(InstrumentationCounter& counter, std::uint64_t elements)
+        : counter_(counter), elements_(elements), start_(std::chrono::steady_clock::now())
+    {}
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator = (const ScopedTimer&) = delete;
+
+    ~ScopedTimer()
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - start_;
+        counter_.add(elements_, static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+private:
+    InstrumentationCounter& counter_;
+    std::uint64_t elements_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}   // namespace dcn
+
+#include "dualcomplex_instrument.h"
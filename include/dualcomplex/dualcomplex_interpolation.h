@@ -9,6 +9,7 @@
 #include "dualcomplex_common.h"
 #include "dualcomplex_exponential.h"
 #include "dualcomplex_transform.h"
+#include "dualcomplex_instrument.h"
 
 namespace dcn
 {
@@ -24,6 +25,7 @@ template<typename T>
 DualComplex<T>
 nlerp(const DualComplex<T>& dc0, const DualComplex<T>& dc1, T t)
 {
+    DUALCOMPLEX_INSTRUMENT("nlerp", 1);
     auto res = lerp(dc0, dc1, t);
     return res / norm(res);
 }
@@ -32,6 +34,7 @@ template<typename T>
 DualComplex<T>
 slerp(const DualComplex<T>& dc0, const DualComplex<T>& dc1, T t)
 {
+    DUALCOMPLEX_INSTRUMENT("slerp", 1);
     return dc0 * pow(transformation_difference(dc0, dc1), t);
 }
 
@@ -51,11 +54,12 @@ slerp_shortestpath(const DualComplex<T>& dc0, const DualComplex<T>& dc1, T t)
 /**
  * Dual complex Linear Blending.
  */
-template<typename T>
+template<typename T, typename A1, typename A2>
 DualComplex<T>
-dlb(const std::vector<DualComplex<T>>& transforms, const std::vector<T>& weights)
+dlb(const std::vector<DualComplex<T>, A1>& transforms, const std::vector<T, A2>& weights)
 {
     assert(transforms.size() == weights.size());
+    DUALCOMPLEX_INSTRUMENT("dlb", transforms.size());
 
     constexpr auto zero = static_cast<T>(0);
     auto res = DualComplex<T>(zero, zero, zero, zero);
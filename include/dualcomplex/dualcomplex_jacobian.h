@@ -0,0 +1,206 @@
+/**
+ * @file dualcomplex/dualcomplex_jacobian.h
+ * @brief This file provides Lie-algebra Jacobians for dual complex types.
+ *
+ * Tangent vectors are Eigen::Matrix<T, 3, 1> ordered as (x, y, theta).
+ * All Jacobians use right (local) perturbations, X (+) tau = X * exp(hat(tau)),
+ * and assume unit dual complex numbers.
+ */
+#pragma once
+
+#include <cmath>
+#include <Eigen/Core>
+#include "dualcomplex_common.h"
+#include "dualcomplex_exponential.h"
+
+namespace dcn
+{
+
+/**
+ * Maps a tangent vector to a pure dual complex number, so that exp(hat(tau)) is a transformation.
+ */
+template<typename T>
+DualComplex<T>
+hat(const Eigen::Matrix<T, 3, 1>& tau)
+{
+    constexpr auto half = static_cast<T>(0.5);
+    return DualComplex<T>(
+        std::complex<T>(static_cast<T>(0), half * tau(2)),
+        std::complex<T>(half * tau(0), half * tau(1)));
+}
+
+/**
+ * Maps a pure dual complex number, such as log(dc), to a tangent vector.
+ */
+template<typename T>
+Eigen::Matrix<T, 3, 1>
+vee(const DualComplex<T>& dc)
+{
+    constexpr auto two = static_cast<T>(2);
+    return Eigen::Matrix<T, 3, 1>(
+        two * dc.dual().real(),
+        two * dc.dual().imag(),
+        two * dc.real().imag());
+}
+
+/**
+ * Returns the adjoint matrix of a unit dual complex number.
+ */
+template<typename T>
+Eigen::Matrix<T, 3, 3>
+adjoint(const DualComplex<T>& dc)
+{
+    const auto rot = dc.real() * dc.real();
+    const auto t = static_cast<T>(2) * dc.real() * dc.dual();
+
+    Eigen::Matrix<T, 3, 3> m;
+    m << rot.real(),-rot.imag(), t.imag(),
+         rot.imag(), rot.real(),-t.real(),
+         static_cast<T>(0), static_cast<T>(0), static_cast<T>(1);
+    return m;
+}
+
+/**
+ * Right Jacobian of exp(hat(tau)).
+ */
+template<typename T>
+Eigen::Matrix<T, 3, 3>
+right_jacobian(const Eigen::Matrix<T, 3, 1>& tau)
+{
+    Eigen::Matrix<T, 3, 3> m = Eigen::Matrix<T, 3, 3>::Identity();
+    m(0,2) =-tau(1);
+    m(1,2) = tau(0);
+    return m;
+}
+
+/**
+ * Inverse of the right Jacobian of exp(hat(tau)).
+ */
+template<typename T>
+Eigen::Matrix<T, 3, 3>
+inverse_right_jacobian(const Eigen::Matrix<T, 3, 1>& tau)
+{
+    Eigen::Matrix<T, 3, 3> m = Eigen::Matrix<T, 3, 3>::Identity();
+    m(0,2) = tau(1);
+    m(1,2) =-tau(0);
+    return m;
+}
+
+/**
+ * Left Jacobian of exp(hat(tau)).
+ */
+template<typename T>
+Eigen::Matrix<T, 3, 3>
+left_jacobian(const Eigen::Matrix<T, 3, 1>& tau)
+{
+    const auto c = std::cos(tau(2));
+    const auto s = std::sin(tau(2));
+
+    Eigen::Matrix<T, 3, 3> m = Eigen::Matrix<T, 3, 3>::Identity();
+    m(0,0) = c; m(0,1) =-s;
+    m(1,0) = s; m(1,1) = c;
+    return m;
+}
+
+/**
+ * Inverse of the left Jacobian of exp(hat(tau)).
+ */
+template<typename T>
+Eigen::Matrix<T, 3, 3>
+inverse_left_jacobian(const Eigen::Matrix<T, 3, 1>& tau)
+{
+    const auto c = std::cos(tau(2));
+    const auto s = std::sin(tau(2));
+
+    Eigen::Matrix<T, 3, 3> m = Eigen::Matrix<T, 3, 3>::Identity();
+    m(0,0) = c; m(0,1) = s;
+    m(1,0) =-s; m(1,1) = c;
+    return m;
+}
+
+/**
+ * Jacobian of inverse(dc) with respect to dc.
+ */
+template<typename T>
+Eigen::Matrix<T, 3, 3>
+jacobian_of_inverse(const DualComplex<T>& dc)
+{
+    return -adjoint(dc);
+}
+
+/**
+ * Jacobian of lhs * rhs with respect to lhs.
+ */
+template<typename T>
+Eigen::Matrix<T, 3, 3>
+jacobian_of_product_lhs(const DualComplex<T>& lhs, const DualComplex<T>& rhs)
+{
+    static_cast<void>(lhs);
+    return adjoint(inverse(rhs));
+}
+
+/**
+ * Jacobian of lhs * rhs with respect to rhs.
+ */
+template<typename T>
+Eigen::Matrix<T, 3, 3>
+jacobian_of_product_rhs(const DualComplex<T>& lhs, const DualComplex<T>& rhs)
+{
+    static_cast<void>(lhs);
+    static_cast<void>(rhs);
+    return Eigen::Matrix<T, 3, 3>::Identity();
+}
+
+/**
+ * Jacobian of transform(p, v) with respect to p.
+ */
+template<typename T>
+Eigen::Matrix<T, 2, 3>
+jacobian_of_transform_pose(const DualComplex<T>& p, const std::complex<T>& v)
+{
+    const auto rot = p.real() * p.real();
+    const auto rv = rot * std::complex<T>(-v.imag(), v.real());
+
+    Eigen::Matrix<T, 2, 3> m;
+    m << rot.real(),-rot.imag(), rv.real(),
+         rot.imag(), rot.real(), rv.imag();
+    return m;
+}
+
+/**
+ * Jacobian of transform(p, v) with respect to v.
+ */
+template<typename T>
+Eigen::Matrix<T, 2, 2>
+jacobian_of_transform_vector(const DualComplex<T>& p, const std::complex<T>& v)
+{
+    static_cast<void>(v);
+    const auto rot = p.real() * p.real();
+
+    Eigen::Matrix<T, 2, 2> m;
+    m << rot.real(),-rot.imag(),
+         rot.imag(), rot.real();
+    return m;
+}
+
+/**
+ * Jacobian of vee(log(dc)) with respect to dc.
+ */
+template<typename T>
+Eigen::Matrix<T, 3, 3>
+jacobian_of_log(const DualComplex<T>& dc)
+{
+    return inverse_right_jacobian(vee(log(dc)));
+}
+
+/**
+ * Jacobian of exp(hat(tau)) with respect to tau.
+ */
+template<typename T>
+Eigen::Matrix<T, 3, 3>
+jacobian_of_exp(const Eigen::Matrix<T, 3, 1>& tau)
+{
+    return right_jacobian(tau);
+}
+
+}   // namespace dcn
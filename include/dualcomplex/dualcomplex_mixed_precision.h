@@ -0,0 +1,174 @@
+/**
+ * @file dualcomplex/dualcomplex_mixed_precision.h
+ * @brief This file provides reduced-precision storage and double-precision accumulation for dual complex types.
+ *
+ * Transformations may be stored as DualComplex<float> or as PackedDualComplex, four bfloat16 values in 8 bytes,
+ * while blending, composition scans and means accumulate in double.
+ */
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "dualcomplex_common.h"
+#include "dualcomplex_instrument.h"
+
+namespace dcn
+{
+
+/**
+ * Brain floating point, the upper 16 bits of an IEEE 754 binary32.
+ */
+struct bfloat16
+{
+    std::uint16_t bits;
+};
+
+/**
+ * Converts to bfloat16, rounding to nearest even.
+ */
+inline bfloat16
+to_bfloat16(float x)
+{
+    std::uint32_t u;
+    std::memcpy(&u, &x, sizeof(u));
+    bfloat16 res;
+    if(std::isnan(x))
+    {
+        res.bits = static_cast<std::uint16_t>((u >> 16) | 0x0040u);
+        return res;
+    }
+    u += 0x7fffu + ((u >> 16) & 1u);
+    res.bits = static_cast<std::uint16_t>(u >> 16);
+    return res;
+}
+
+inline float
+to_float(bfloat16 x)
+{
+    const auto u = static_cast<std::uint32_t>(x.bits) << 16;
+    float res;
+    std::memcpy(&res, &u, sizeof(res));
+    return res;
+}
+
+/**
+ * Dual complex number stored as four bfloat16 values.
+ * About three significant decimal digits, suited to archives rather than to further arithmetic.
+ */
+struct PackedDualComplex
+{
+    bfloat16 components[4];
+};
+
+template<typename T>
+PackedDualComplex
+pack(const DualComplex<T>& dc)
+{
+    PackedDualComplex res;
+    res.components[0] = to_bfloat16(static_cast<float>(dc.real().real()));
+    res.components[1] = to_bfloat16(static_cast<float>(dc.real().imag()));
+    res.components[2] = to_bfloat16(static_cast<float>(dc.dual().real()));
+    res.components[3] = to_bfloat16(static_cast<float>(dc.dual().imag()));
+    return res;
+}
+
+template<typename T>
+DualComplex<T>
+unpack(const PackedDualComplex& packed)
+{
+    return DualComplex<T>(
+        static_cast<T>(to_float(packed.components[0])), static_cast<T>(to_float(packed.components[1])),
+        static_cast<T>(to_float(packed.components[2])), static_cast<T>(to_float(packed.components[3])));
+}
+
+namespace detail
+{
+
+template<typename T>
+DualComplex<double>
+widen(const DualComplex<T>& dc)
+{
+    return DualComplex<double>(dc);
+}
+
+inline DualComplex<double>
+widen(const PackedDualComplex& dc)
+{
+    return unpack<double>(dc);
+}
+
+template<typename T>
+void
+narrow(const DualComplex<double>& dc, DualComplex<T>& out)
+{
+    out = DualComplex<T>(dc);
+}
+
+inline void
+narrow(const DualComplex<double>& dc, PackedDualComplex& out)
+{
+    out = pack(dc);
+}
+
+}   // namespace detail
+
+/**
+ * Dual complex Linear Blending, accumulated in double.
+ * S is DualComplex<float>, DualComplex<double> or PackedDualComplex, W is float or double.
+ */
+template<typename S, typename W>
+DualComplex<double>
+accumulate_dlb(const S* transforms, const W* weights, std::size_t count)
+{
+    DUALCOMPLEX_INSTRUMENT("accumulate_dlb", count);
+
+    auto res = DualComplex<double>(0.0, 0.0, 0.0, 0.0);
+    for(std::size_t i = 0; i < count; i++)
+        res += detail::widen(transforms[i]) * static_cast<double>(weights[i]);
+    return res / norm(res);
+}
+
+/**
+ * Inclusive composition scan, out[i] = transforms[0] * ... * transforms[i], accumulated in double.
+ * The running product is renormalized at every step and out may alias transforms.
+ */
+template<typename S>
+void
+accumulate_composition(const S* transforms, std::size_t count, S* out)
+{
+    DUALCOMPLEX_INSTRUMENT("accumulate_composition", count);
+
+    auto acc = DualComplex<double>(1.0, 0.0, 0.0, 0.0);
+    for(std::size_t i = 0; i < count; i++)
+    {
+        acc = normalize(acc * detail::widen(transforms[i]));
+        detail::narrow(acc, out[i]);
+    }
+}
+
+/**
+ * Returns the normalized average of the transformations, accumulated in double.
+ * Every element is first brought to the sign of the first one, so that dc and -dc do not cancel.
+ */
+template<typename S>
+DualComplex<double>
+accumulate_mean(const S* transforms, std::size_t count)
+{
+    assert(count > 0);
+    DUALCOMPLEX_INSTRUMENT("accumulate_mean", count);
+
+    const auto first = detail::widen(transforms[0]);
+    auto res = first;
+    for(std::size_t i = 1; i < count; i++)
+    {
+        const auto dc = detail::widen(transforms[i]);
+        const auto dot = first.real().real() * dc.real().real() + first.real().imag() * dc.real().imag();
+        res += (dot < 0.0) ? -dc : dc;
+    }
+    return res / norm(res);
+}
+
+}   // namespace dcn
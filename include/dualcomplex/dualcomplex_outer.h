@@ -0,0 +1,127 @@
+/**
+ * @file dualcomplex/dualcomplex_outer.h
+ * @brief This file provides all-pairs composition and difference of two sets of transformations.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include "dualcomplex_common.h"
+#include "dualcomplex_parallel.h"
+#include "dualcomplex_instrument.h"
+
+namespace dcn
+{
+
+namespace detail
+{
+
+/**
+ * Computes out[i * n + j] = (conjugate ? total_conjugate(lhs[i]) : lhs[i]) * rhs[j].
+ *
+ * Columns are processed in tiles whose components are copied to separate arrays that stay in L1.
+ * The inner loop always runs over a whole tile, zero-padded past the last column, into separate product arrays,
+ * so that it has a fixed trip count and no interleaved stores; the columns in range are then copied to out.
+ * Rows are distributed over the threads.
+ */
+template<typename T>
+void
+outer_multiply(
+    const DualComplex<T>* lhs,
+    std::size_t m,
+    const DualComplex<T>* rhs,
+    std::size_t n,
+    DualComplex<T>* out,
+    bool conjugate,
+    unsigned num_threads)
+{
+    constexpr std::size_t tile = 256;
+
+    parallel_for(m, num_threads,
+        [=](std::size_t row_begin, std::size_t row_end)
+        {
+            T cr[tile], ci[tile], dr[tile], di[tile];
+            T xr[tile], xi[tile], yr[tile], yi[tile];
+
+            for(std::size_t j0 = 0; j0 < n; j0 += tile)
+            {
+                const auto count = std::min(tile, n - j0);
+                for(std::size_t j = 0; j < count; j++)
+                {
+                    const auto& q = rhs[j0 + j];
+                    cr[j] = q.real().real();
+                    ci[j] = q.real().imag();
+                    dr[j] = q.dual().real();
+                    di[j] = q.dual().imag();
+                }
+                std::fill(cr + count, cr + tile, static_cast<T>(0));
+                std::fill(ci + count, ci + tile, static_cast<T>(0));
+                std::fill(dr + count, dr + tile, static_cast<T>(0));
+                std::fill(di + count, di + tile, static_cast<T>(0));
+
+                for(std::size_t i = row_begin; i < row_end; i++)
+                {
+                    const auto p = conjugate ? total_conjugate(lhs[i]) : lhs[i];
+                    const auto ar = p.real().real();
+                    const auto ai = p.real().imag();
+                    const auto br = p.dual().real();
+                    const auto bi = p.dual().imag();
+
+                    // (a + eb)(c + ed) = ac + e(b conj(c) + ad)
+                    for(std::size_t j = 0; j < tile; j++)
+                    {
+                        xr[j] = ar * cr[j] - ai * ci[j];
+                        xi[j] = ar * ci[j] + ai * cr[j];
+                        yr[j] = br * cr[j] + bi * ci[j] + ar * dr[j] - ai * di[j];
+                        yi[j] = bi * cr[j] - br * ci[j] + ar * di[j] + ai * dr[j];
+                    }
+
+                    auto row = out + i * n + j0;
+                    for(std::size_t j = 0; j < count; j++)
+                        row[j] = DualComplex<T>(xr[j], xi[j], yr[j], yi[j]);
+                }
+            }
+        });
+}
+
+}   // namespace detail
+
+/**
+ * Composes every transformation of lhs with every transformation of rhs,
+ * out[i * n + j] = lhs[i] * rhs[j] for an m x n row-major out.
+ * num_threads of zero uses one thread per hardware thread.
+ */
+template<typename T>
+void
+compose_outer(
+    const DualComplex<T>* lhs,
+    std::size_t m,
+    const DualComplex<T>* rhs,
+    std::size_t n,
+    DualComplex<T>* out,
+    unsigned num_threads = 1)
+{
+    DUALCOMPLEX_INSTRUMENT("compose_outer", m * n);
+    detail::outer_multiply(lhs, m, rhs, n, out, false, num_threads);
+}
+
+/**
+ * Computes the difference of every pair,
+ * out[i * n + j] = transformation_difference(lhs[i], rhs[j]) for an m x n row-major out.
+ * num_threads of zero uses one thread per hardware thread.
+ */
+template<typename T>
+void
+transformation_difference_outer(
+    const DualComplex<T>* lhs,
+    std::size_t m,
+    const DualComplex<T>* rhs,
+    std::size_t n,
+    DualComplex<T>* out,
+    unsigned num_threads = 1)
+{
+    DUALCOMPLEX_INSTRUMENT("transformation_difference_outer", m * n);
+    detail::outer_multiply(lhs, m, rhs, n, out, true, num_threads);
+}
+
+}   // namespace dcn
@@ -0,0 +1,117 @@
+/**
+ * @file dualcomplex/dualcomplex_parallel.h
+ * @brief This file provides a minimal thread fork-join helper for bulk operations.
+ */
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dcn
+{
+
+namespace detail
+{
+
+/**
+ * Returns the number of threads to use, where zero means one per hardware thread.
+ */
+inline unsigned
+resolve_num_threads(unsigned num_threads)
+{
+    if(num_threads == 0)
+        num_threads = std::thread::hardware_concurrency();
+    return std::max(num_threads, 1u);
+}
+
+/**
+ * Splits [0, count) into contiguous chunks and calls fn(begin, end) for each one on its own thread.
+ * The calling thread processes the first chunk.
+ */
+template<typename F>
+void
+parallel_for(std::size_t count, unsigned num_threads, F fn)
+{
+    const auto threads = std::min<std::size_t>(resolve_num_threads(num_threads), count);
+    if(threads <= 1)
+    {
+        fn(static_cast<std::size_t>(0), count);
+        return;
+    }
+
+    const auto chunk = (count + threads - 1) / threads;
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for(auto begin = chunk; begin < count; begin += chunk)
+    {
+        const auto end = std::min(begin + chunk, count);
+        workers.emplace_back([&fn, begin, end](){ fn(begin, end); });
+    }
+    fn(static_cast<std::size_t>(0), std::min(chunk, count));
+
+    for(auto& worker : workers)
+        worker.join();
+}
+
+/**
+ * Reusable barrier at which a fixed number of threads wait for each other.
+ */
+class Barrier
+{
+public:
+    explicit Barrier(std::size_t count)
+        : count_(count), waiting_(0), generation_(0)
+    {}
+
+    Barrier(const Barrier&) = delete;
+    Barrier& operator = (const Barrier&) = delete;
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        const auto generation = generation_;
+        if(++waiting_ == count_)
+        {
+            waiting_ = 0;
+            generation_++;
+            condition_.notify_all();
+            return;
+        }
+        condition_.wait(lock, [&](){ return generation != generation_; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::size_t count_;
+    std::size_t waiting_;
+    std::size_t generation_;
+};
+
+/**
+ * Calls fn(thread, threads) once on each of threads threads, which live for the whole call,
+ * so that loops of parallel steps separated by a Barrier do not spawn threads per step.
+ * The calling thread is thread zero.
+ */
+template<typename F>
+void
+parallel_team(unsigned threads, F fn)
+{
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for(unsigned thread = 1; thread < threads; thread++)
+        workers.emplace_back([&fn, thread, threads](){ fn(thread, threads); });
+    fn(0u, threads);
+
+    for(auto& worker : workers)
+        worker.join();
+}
+
+}   // namespace detail
+
+}   // namespace dcn
@@ -0,0 +1,438 @@
+/**
+ * @file dualcomplex/dualcomplex_pipeline.h
+ * @brief This file provides chunked streaming pipelines for dual complex types.
+ *
+ * A pipeline pulls chunks of poses from a source, runs every stage on a chunk while it is still in L1,
+ * and hands the chunk to a sink:
+ *
+ *     dcn::PosePipeline<float> pipeline;
+ *     pipeline.then(dcn::compose_left_stage(sensor_to_world))
+ *             .then(dcn::normalize_stage<float>())
+ *             .split()    // The following stages run on a thread of their own.
+ *             .then(dcn::unit_filter_stage(1e-4f));
+ *     pipeline.run(dcn::rotation_source(headings.data(), headings.size()), dcn::append_sink(poses));
+ *
+ * Stages, sources and sinks must not throw.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "dualcomplex_common.h"
+#include "dualcomplex_transform.h"
+#include "dualcomplex_query.h"
+#include "dualcomplex_interpolation.h"
+
+namespace dcn
+{
+
+/**
+ * Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ */
+template<typename T>
+class SpscQueue
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+/* Constructors */
+    /**
+     * Holds at least capacity elements, rounded up to a power of two.
+     */
+    explicit SpscQueue(size_type capacity)
+        : slots_(round_up(capacity)), mask_(slots_.size() - 1), head_(0), tail_(0), closed_(false)
+    {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator = (const SpscQueue&) = delete;
+
+/* Accessors */
+    size_type capacity() const noexcept { return slots_.size(); }
+    bool closed() const noexcept { return closed_.load(std::memory_order_acquire); }
+
+/* Modifiers */
+    /**
+     * Producer side, returns false if the queue is full.
+     */
+    bool try_push(T&& value)
+    {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        if(tail - head_.load(std::memory_order_acquire) == slots_.size())
+            return false;
+
+        slots_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const T& value)
+    {
+        T temp(value);
+        return try_push(std::move(temp));
+    }
+
+    /**
+     * Producer side, waits while the queue is full.
+     */
+    void push(T value)
+    {
+        while(!try_push(std::move(value)))
+            std::this_thread::yield();
+    }
+
+    /**
+     * Producer side, signals that nothing more will be pushed.
+     */
+    void close() noexcept
+    {
+        closed_.store(true, std::memory_order_release);
+    }
+
+    /**
+     * Consumer side, returns false if the queue is empty.
+     */
+    bool try_pop(T& value)
+    {
+        const auto head = head_.load(std::memory_order_relaxed);
+        if(head == tail_.load(std::memory_order_acquire))
+            return false;
+
+        value = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer side, waits for an element and returns false once the queue is closed and drained.
+     */
+    bool pop(T& value)
+    {
+        for(;;)
+        {
+            if(try_pop(value))
+                return true;
+            if(closed())
+                return try_pop(value);
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    static size_type round_up(size_type capacity)
+    {
+        size_type res = 1;
+        while(res < capacity)
+            res <<= 1;
+        return res;
+    }
+
+    std::vector<T> slots_;
+    size_type mask_;
+    // Padding keeps the indices written by the two threads on separate cache lines.
+    char padding0_[64];
+    std::atomic<size_type> head_;   // Written by the consumer.
+    char padding1_[64];
+    std::atomic<size_type> tail_;   // Written by the producer.
+    char padding2_[64];
+    std::atomic<bool> closed_;
+};
+
+/**
+ * Sequence of in-place stages over chunks of poses, optionally split into segments that run concurrently.
+ *
+ * A stage may change the values and the number of poses in a chunk.
+ * Within a segment all stages run on one chunk before the next chunk is read.
+ * Consecutive segments are connected by SpscQueues and run on separate threads,
+ * the last one on the calling thread together with the sink.
+ * Stages keep their state between calls of run().
+ */
+template<typename T>
+class PosePipeline
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using chunk_type = std::vector<DualComplex<T>>;
+    using stage_type = std::function<void(chunk_type&)>;
+
+/* Constructors */
+    explicit PosePipeline(size_type chunk_size = 256, size_type queue_capacity = 4)
+        : chunk_size_(std::max<size_type>(chunk_size, 1)), queue_capacity_(std::max<size_type>(queue_capacity, 1)),
+          segments_(1)
+    {}
+
+/* Accessors */
+    size_type chunk_size() const noexcept { return chunk_size_; }
+    size_type num_segments() const noexcept { return segments_.size(); }
+
+/* Modifiers */
+    /**
+     * Appends a stage to the last segment.
+     */
+    PosePipeline& then(stage_type stage)
+    {
+        segments_.back().push_back(std::move(stage));
+        return *this;
+    }
+
+    /**
+     * Starts a new segment, to run on a thread of its own.
+     */
+    PosePipeline& split()
+    {
+        if(!segments_.back().empty())
+            segments_.emplace_back();
+        return *this;
+    }
+
+/* Operations */
+    /**
+     * Runs every stage of every segment on one chunk.
+     */
+    void process(chunk_type& chunk)
+    {
+        for(size_type i = 0; i < segments_.size(); i++)
+            process_segment(i, chunk);
+    }
+
+    /**
+     * Streams until the source is exhausted.
+     *
+     * source(chunk, chunk_size) appends up to chunk_size poses to an empty chunk and returns false when exhausted,
+     * sink(chunk) consumes a processed chunk.
+     * After split(), the source runs on a worker thread together with the first segment,
+     * so that it must not touch state shared with the caller without synchronization; the sink runs on the calling thread.
+     */
+    template<typename Source, typename Sink>
+    void run(Source source, Sink sink);
+
+private:
+    void process_segment(size_type i, chunk_type& chunk)
+    {
+        for(auto& stage : segments_[i])
+            stage(chunk);
+    }
+
+    size_type chunk_size_;
+    size_type queue_capacity_;
+    std::vector<std::vector<stage_type>> segments_;
+};
+
+template<typename T>
+template<typename Source, typename Sink>
+void
+PosePipeline<T>::run(Source source, Sink sink)
+{
+    const auto n = segments_.size();
+    if(n == 1)
+    {
+        chunk_type chunk;
+        chunk.reserve(chunk_size_);
+        for(;;)
+        {
+            chunk.clear();
+            if(!source(chunk, chunk_size_))
+                break;
+            process_segment(0, chunk);
+            sink(static_cast<const chunk_type&>(chunk));
+        }
+        return;
+    }
+
+    // links[i] carries chunks from segment i to segment i + 1,
+    // and recycled returns them from the last segment to the first one.
+    using queue_type = SpscQueue<chunk_type>;
+    std::vector<std::unique_ptr<queue_type>> links;
+    for(size_type i = 0; i + 1 < n; i++)
+        links.emplace_back(new queue_type(queue_capacity_));
+    queue_type recycled((n - 1) * links.front()->capacity() + n);
+
+    std::vector<std::thread> workers;
+    workers.reserve(n - 1);
+    workers.emplace_back([&]()
+    {
+        chunk_type chunk;
+        for(;;)
+        {
+            if(!recycled.try_pop(chunk))
+            {
+                chunk = chunk_type();
+                chunk.reserve(chunk_size_);
+            }
+            chunk.clear();
+            if(!source(chunk, chunk_size_))
+                break;
+            process_segment(0, chunk);
+            links[0]->push(std::move(chunk));
+        }
+        links[0]->close();
+    });
+    for(size_type i = 1; i + 1 < n; i++)
+    {
+        workers.emplace_back([&, i]()
+        {
+            chunk_type chunk;
+            while(links[i - 1]->pop(chunk))
+            {
+                process_segment(i, chunk);
+                links[i]->push(std::move(chunk));
+            }
+            links[i]->close();
+        });
+    }
+
+    chunk_type chunk;
+    while(links[n - 2]->pop(chunk))
+    {
+        process_segment(n - 1, chunk);
+        sink(static_cast<const chunk_type&>(chunk));
+        recycled.try_push(std::move(chunk));
+    }
+
+    for(auto& worker : workers)
+        worker.join();
+}
+
+/* Sources */
+
+/**
+ * Reads poses from an array that must outlive the run.
+ */
+template<typename T>
+std::function<bool(std::vector<DualComplex<T>>&, std::size_t)>
+array_source(const DualComplex<T>* data, std::size_t count)
+{
+    std::size_t offset = 0;
+    return [=](std::vector<DualComplex<T>>& chunk, std::size_t chunk_size) mutable
+    {
+        const auto n = std::min(chunk_size, count - offset);
+        chunk.insert(chunk.end(), data + offset, data + offset + n);
+        offset += n;
+        return n > 0;
+    };
+}
+
+/**
+ * Converts headings, read from an array that must outlive the run, to rotations.
+ */
+template<typename T>
+std::function<bool(std::vector<DualComplex<T>>&, std::size_t)>
+rotation_source(const T* angles, std::size_t count)
+{
+    std::size_t offset = 0;
+    return [=](std::vector<DualComplex<T>>& chunk, std::size_t chunk_size) mutable
+    {
+        const auto n = std::min(chunk_size, count - offset);
+        for(std::size_t i = 0; i < n; i++)
+            chunk.push_back(rotation(angles[offset + i]));
+        offset += n;
+        return n > 0;
+    };
+}
+
+/* Stages */
+
+/**
+ * Replaces every pose p with lhs * p.
+ */
+template<typename T>
+std::function<void(std::vector<DualComplex<T>>&)>
+compose_left_stage(const DualComplex<T>& lhs)
+{
+    return [lhs](std::vector<DualComplex<T>>& chunk)
+    {
+        for(auto& dc : chunk)
+            dc = lhs * dc;
+    };
+}
+
+/**
+ * Replaces every pose p with p * rhs.
+ */
+template<typename T>
+std::function<void(std::vector<DualComplex<T>>&)>
+compose_right_stage(const DualComplex<T>& rhs)
+{
+    return [rhs](std::vector<DualComplex<T>>& chunk)
+    {
+        for(auto& dc : chunk)
+            dc *= rhs;
+    };
+}
+
+template<typename T>
+std::function<void(std::vector<DualComplex<T>>&)>
+normalize_stage()
+{
+    return [](std::vector<DualComplex<T>>& chunk)
+    {
+        for(auto& dc : chunk)
+            dc = normalize(dc);
+    };
+}
+
+/**
+ * Drops the poses that are not unit.
+ */
+template<typename T>
+std::function<void(std::vector<DualComplex<T>>&)>
+unit_filter_stage(T tolerance)
+{
+    return [tolerance](std::vector<DualComplex<T>>& chunk)
+    {
+        chunk.erase(
+            std::remove_if(chunk.begin(), chunk.end(),
+                [tolerance](const DualComplex<T>& dc){ return !is_unit(dc, tolerance); }),
+            chunk.end());
+    };
+}
+
+/**
+ * Exponential smoothing along the stream, p[i] = slerp_shortestpath(p[i - 1], p[i], t).
+ * The result is renormalized, since the norm error of p[i - 1] would otherwise grow by a factor of 1 + t per pose.
+ * The state carries over between chunks and between calls of PosePipeline::run(), which continue smoothing
+ * from the last pose of the previous run, so the stage must not be shared between pipelines
+ * and a new one should be created to smooth an unrelated stream.
+ */
+template<typename T>
+std::function<void(std::vector<DualComplex<T>>&)>
+smoothing_stage(T t)
+{
+    auto started = false;
+    DualComplex<T> previous;
+    return [=](std::vector<DualComplex<T>>& chunk) mutable
+    {
+        for(auto& dc : chunk)
+        {
+            if(started)
+                dc = normalize(slerp_shortestpath(previous, dc, t));
+            previous = dc;
+            started = true;
+        }
+    };
+}
+
+/* Sinks */
+
+/**
+ * Appends the poses to a vector that must outlive the run.
+ */
+template<typename T>
+std::function<void(const std::vector<DualComplex<T>>&)>
+append_sink(std::vector<DualComplex<T>>& out)
+{
+    auto p = &out;
+    return [p](const std::vector<DualComplex<T>>& chunk)
+    {
+        p->insert(p->end(), chunk.begin(), chunk.end());
+    };
+}
+
+}   // namespace dcn
@@ -0,0 +1,276 @@
+/**
+ * @file dualcomplex/dualcomplex_pose_buffer.h
+ * @brief This file provides a timestamped history of poses with interpolated lookup for dual complex types.
+ */
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "dualcomplex_pose_interpolant.h"
+#include "dualcomplex_batch_query.h"
+
+namespace dcn
+{
+
+/**
+ * Fixed-capacity history of timestamped poses, where the oldest entry is overwritten when full.
+ *
+ * Lookups interpolate between the entries that bracket the requested time.
+ * All member functions may be called concurrently. Lookups hold the lock only to locate and copy
+ * the bracketing entries and interpolate after releasing it, and a batch lookup locks once per 64 times,
+ * so that readers contend only for short copies and a large batch does not hold off writers.
+ * Time may be a floating point or an integer type such as nanoseconds.
+ */
+template<typename T, typename Time = double>
+class PoseBuffer
+{
+public:
+    using value_type = T;
+    using time_type = Time;
+    using size_type = std::size_t;
+
+/* Constructors */
+    explicit PoseBuffer(size_type capacity)
+        : stamps_(capacity), poses_(capacity), head_(0), size_(0)
+    {
+        assert(capacity >= 2);
+    }
+
+    PoseBuffer(const PoseBuffer&) = delete;
+    PoseBuffer& operator = (const PoseBuffer&) = delete;
+
+/* Accessors */
+    size_type capacity() const noexcept { return stamps_.size(); }
+
+    size_type size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return size_;
+    }
+
+    /**
+     * Returns the oldest and newest timestamps, or false if the buffer is empty.
+     */
+    bool time_range(Time& oldest, Time& newest) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(size_ == 0)
+            return false;
+        oldest = stamp(0);
+        newest = stamp(size_ - 1);
+        return true;
+    }
+
+/* Modifiers */
+    /**
+     * Appends a unit pose. Returns false, leaving the buffer unchanged,
+     * unless the timestamp is later than the newest one.
+     */
+    bool insert(Time time, const DualComplex<T>& pose)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(size_ > 0 && !(stamp(size_ - 1) < time))
+            return false;
+
+        const auto i = physical(size_);
+        stamps_[i] = time;
+        poses_[i] = pose;
+        if(size_ < capacity())
+            size_++;
+        else
+            head_ = physical(1);
+        return true;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        head_ = 0;
+        size_ = 0;
+    }
+
+/* Operations */
+    /**
+     * Interpolates the pose at a time, or returns false if the time is outside the buffered range.
+     */
+    bool lookup(Time time, DualComplex<T>& pose) const
+    {
+        Bracket bracket;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            size_type i;
+            if(!find(time, 0, i))
+                return false;
+            copy_bracket(i, time, bracket);
+        }
+        pose = bracket.last
+             ? bracket.p0
+             : detail::PoseInterpolant<T>(bracket.p0, bracket.p1).evaluate(bracket.parameter);
+        return true;
+    }
+
+    /**
+     * Interpolates the poses at many times, in any order, and returns how many were within the buffered range.
+     *
+     * Bit i % 64 of mask[i / 64] is set if poses[i] was written; the mask may be null.
+     * Runs of non-decreasing times are resolved by a forward scan from the previous bracket,
+     * and queries in the same bracket share one interpolant, so sorted batches cost amortized O(1) per time.
+     */
+    size_type lookup(const Time* times, size_type count, DualComplex<T>* poses, std::uint64_t* mask) const
+    {
+        constexpr size_type block = 64;
+        Bracket brackets[block];
+        bool found[block];
+
+        auto cursor = npos;
+        auto previous = Time();
+        detail::PoseInterpolant<T> interpolant;
+        auto interpolant_index = npos;
+        return detail::evaluate_mask(count, mask,
+            [&](size_type k)
+            {
+                const auto j = k % block;
+                if(j == 0)
+                {
+                    // Copies the brackets of the next block under the lock. The buffer may change between blocks,
+                    // so that the search restarts and the interpolant is not reused across them.
+                    const auto n = (count - k < block) ? count - k : block;
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    for(size_type l = 0; l < n; l++)
+                    {
+                        const auto time = times[k + l];
+                        const auto hint = (cursor != npos && !(time < previous)) ? cursor : 0;
+                        size_type i;
+                        found[l] = find(time, hint, i);
+                        if(!found[l])
+                            continue;
+
+                        cursor = i;
+                        previous = time;
+                        if(l > 0 && found[l - 1] && brackets[l - 1].index == i)
+                        {
+                            brackets[l] = brackets[l - 1];
+                            brackets[l].parameter = brackets[l].last ? static_cast<T>(0) : parameter(i, time);
+                        }
+                        else
+                        {
+                            copy_bracket(i, time, brackets[l]);
+                        }
+                    }
+                    cursor = npos;
+                    interpolant_index = npos;
+                }
+
+                if(!found[j])
+                    return false;
+
+                // Queries in the same bracket share one interpolant.
+                const auto& bracket = brackets[j];
+                if(bracket.last)
+                {
+                    poses[k] = bracket.p0;
+                    return true;
+                }
+                if(bracket.index != interpolant_index)
+                {
+                    interpolant = detail::PoseInterpolant<T>(bracket.p0, bracket.p1);
+                    interpolant_index = bracket.index;
+                }
+                poses[k] = interpolant.evaluate(bracket.parameter);
+                return true;
+            });
+    }
+
+private:
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    /**
+     * The entries bracketing a time, copied out of the buffer so that they can be interpolated without the lock.
+     */
+    struct Bracket
+    {
+        DualComplex<T> p0;
+        DualComplex<T> p1;
+        T parameter;
+        size_type index;
+        bool last;      // The time is that of the newest entry, p0.
+    };
+
+    size_type physical(size_type i) const noexcept
+    {
+        const auto j = head_ + i;
+        return (j < capacity()) ? j : j - capacity();
+    }
+
+    Time stamp(size_type i) const noexcept { return stamps_[physical(i)]; }
+
+    /**
+     * Finds the largest i with stamp(i) <= time, starting from a hint not after it.
+     * The search gallops forward from the hint, so it is cheap when the hint is close.
+     */
+    bool find(Time time, size_type hint, size_type& i) const
+    {
+        if(size_ == 0 || time < stamp(0) || stamp(size_ - 1) < time)
+            return false;
+
+        // stamp(lo) <= time < stamp(hi), with hi == size_ standing for +infinity.
+        auto lo = hint;
+        size_type step = 1;
+        auto hi = lo + step;
+        while(hi < size_ && !(time < stamp(hi)))
+        {
+            lo = hi;
+            step *= 2;
+            hi = lo + step;
+        }
+        if(hi > size_)
+            hi = size_;
+
+        while(hi - lo > 1)
+        {
+            const auto mid = lo + (hi - lo) / 2;
+            if(time < stamp(mid))
+                hi = mid;
+            else
+                lo = mid;
+        }
+        i = lo;
+        return true;
+    }
+
+    T parameter(size_type i, Time time) const
+    {
+        const auto t0 = stamp(i);
+        return static_cast<T>(time - t0) / static_cast<T>(stamp(i + 1) - t0);
+    }
+
+    void copy_bracket(size_type i, Time time, Bracket& bracket) const
+    {
+        bracket.index = i;
+        bracket.last = (i == size_ - 1);
+        bracket.p0 = poses_[physical(i)];
+        if(bracket.last)
+        {
+            bracket.parameter = static_cast<T>(0);
+            return;
+        }
+        bracket.p1 = poses_[physical(i + 1)];
+        bracket.parameter = parameter(i, time);
+    }
+
+    std::vector<Time> stamps_;
+    std::vector<DualComplex<T>> poses_;
+    size_type head_;
+    size_type size_;
+    mutable std::mutex mutex_;
+};
+
+template<typename T, typename Time>
+constexpr typename PoseBuffer<T, Time>::size_type PoseBuffer<T, Time>::npos;
+
+}   // namespace dcn
@@ -0,0 +1,360 @@
+/**
+ * @file dualcomplex/dualcomplex_pose_index.h
+ * @brief This file provides a nearest-pose lookup index for dual complex types.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "dualcomplex_transform.h"
+
+namespace dcn
+{
+
+namespace detail
+{
+
+/**
+ * Returns the angle of a transformation in (-pi, pi].
+ * It is the same for dc and -dc.
+ */
+template<typename T>
+T
+pose_angle(const DualComplex<T>& dc)
+{
+    const auto& r = dc.real();
+    return std::arg(r * r);
+}
+
+/**
+ * Returns the translation of a transformation.
+ * It is the same for dc and -dc.
+ */
+template<typename T>
+std::complex<T>
+pose_translation(const DualComplex<T>& dc)
+{
+    return static_cast<T>(2) * dc.real() * dc.dual();
+}
+
+template<typename T>
+T
+wrap_angle(T angle)
+{
+    const auto pi = static_cast<T>(3.14159265358979323846);
+    angle = std::fmod(angle + pi, static_cast<T>(2) * pi);
+    if(angle <= static_cast<T>(0))
+        angle += static_cast<T>(2) * pi;
+    return angle - pi;
+}
+
+}   // namespace detail
+
+/**
+ * Returns the distance between two unit dual complex numbers,
+ * sqrt(|t0 - t1|^2 + (angle_weight * (theta0 - theta1))^2) with the angle difference wrapped to [-pi, pi].
+ * dc and -dc are at zero distance.
+ */
+template<typename T>
+T
+pose_distance(const DualComplex<T>& dc0, const DualComplex<T>& dc1, T angle_weight)
+{
+    const auto dt = detail::pose_translation(dc0) - detail::pose_translation(dc1);
+    const auto da = angle_weight * detail::wrap_angle(detail::pose_angle(dc0) - detail::pose_angle(dc1));
+    return std::sqrt(std::norm(dt) + da * da);
+}
+
+/**
+ * Spatial hash over unit dual complex numbers for radius and nearest-neighbour queries
+ * in the metric of pose_distance.
+ *
+ * Poses are bucketed by their translation and angle, which do not depend on the sign,
+ * so dc and -dc always land in the same cell. The angle axis wraps around.
+ */
+template<typename T>
+class PoseIndex
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+/* Constructors */
+    /**
+     * cell_size should be close to the typical query radius.
+     */
+    explicit PoseIndex(T cell_size, T angle_weight = static_cast<T>(1))
+        : cell_size_(cell_size), angle_weight_(angle_weight)
+    {
+        assert(cell_size > static_cast<T>(0) && angle_weight >= static_cast<T>(0));
+
+        const auto two_pi = static_cast<T>(2 * 3.14159265358979323846);
+        angle_cells_ = std::max(static_cast<long long>(std::floor(two_pi * angle_weight / cell_size)), 1ll);
+        angle_cell_size_ = two_pi * angle_weight / static_cast<T>(angle_cells_);
+    }
+
+/* Accessors */
+    size_type size() const noexcept { return entries_.size(); }
+    bool empty() const noexcept { return entries_.empty(); }
+    T cell_size() const noexcept { return cell_size_; }
+    T angle_weight() const noexcept { return angle_weight_; }
+
+    const DualComplex<T>& pose(size_type i) const
+    {
+        assert(i < size());
+        return entries_[i].pose;
+    }
+
+/* Modifiers */
+    /**
+     * Adds a pose and returns its index.
+     */
+    size_type insert(const DualComplex<T>& pose)
+    {
+        Entry entry = { pose, detail::pose_translation(pose), detail::pose_angle(pose) };
+        const auto key = cell_of(entry.translation, entry.angle);
+
+        const auto index = entries_.size();
+        entries_.push_back(entry);
+        cells_[key].push_back(index);
+
+        if(index == 0)
+        {
+            min_x_ = max_x_ = key.x;
+            min_y_ = max_y_ = key.y;
+        }
+        else
+        {
+            min_x_ = std::min(min_x_, key.x);
+            max_x_ = std::max(max_x_, key.x);
+            min_y_ = std::min(min_y_, key.y);
+            max_y_ = std::max(max_y_, key.y);
+        }
+        return index;
+    }
+
+    /**
+     * Adds a pose unless one already lies within radius.
+     * Returns the index of the existing or the new pose and whether it was inserted.
+     */
+    std::pair<size_type, bool> insert_unique(const DualComplex<T>& pose, T radius)
+    {
+        const auto found = nearest(pose, nullptr, radius);
+        if(found != npos)
+            return std::make_pair(found, false);
+        return std::make_pair(insert(pose), true);
+    }
+
+    void clear() noexcept
+    {
+        entries_.clear();
+        cells_.clear();
+    }
+
+/* Operations */
+    /**
+     * Returns the indices of the poses within radius, in insertion order.
+     */
+    std::vector<size_type> radius_query(const DualComplex<T>& query, T radius) const
+    {
+        std::vector<size_type> res;
+        if(empty())
+            return res;
+
+        const auto t = detail::pose_translation(query);
+        const auto angle = detail::pose_angle(query);
+        const auto center = cell_of(t, angle);
+
+        const auto reach = static_cast<long long>(std::floor(radius / cell_size_)) + 1;
+        const auto angle_reach = std::min(
+            (angle_weight_ > static_cast<T>(0))
+                ? static_cast<long long>(std::floor(radius / angle_cell_size_)) + 1
+                : 0ll,
+            max_angle_offset());
+
+        for(auto dx = -reach; dx <= reach; dx++)
+        {
+            for(auto dy = -reach; dy <= reach; dy++)
+            {
+                for(auto da = std::max(-angle_reach, min_angle_offset()); da <= angle_reach; da++)
+                {
+                    const auto it = cells_.find(offset(center, dx, dy, da));
+                    if(it == cells_.end())
+                        continue;
+
+                    for(auto i : it->second)
+                    {
+                        if(distance(entries_[i], t, angle) <= radius)
+                            res.push_back(i);
+                    }
+                }
+            }
+        }
+        std::sort(res.begin(), res.end());
+        return res;
+    }
+
+    /**
+     * Returns the index of the nearest pose within max_distance, or npos.
+     */
+    size_type nearest(
+        const DualComplex<T>& query,
+        T* distance_out = nullptr,
+        T max_distance = std::numeric_limits<T>::infinity()) const
+    {
+        auto best = npos;
+        auto best_distance = max_distance;
+        if(!empty())
+        {
+            const auto t = detail::pose_translation(query);
+            const auto angle = detail::pose_angle(query);
+            const auto center = cell_of(t, angle);
+
+            // Search shells of cells at increasing Chebyshev distance. Angle cells are at least cell_size wide,
+            // so anything beyond shell k - 1 is at least (k - 1) * cell_size away.
+            const auto extent = std::max(
+                std::max(std::abs(center.x - min_x_), std::abs(center.x - max_x_)),
+                std::max(std::max(std::abs(center.y - min_y_), std::abs(center.y - max_y_)), max_angle_offset()));
+            for(long long k = 0; k <= extent; k++)
+            {
+                if(static_cast<T>(k - 1) * cell_size_ > best_distance)
+                    break;
+
+                // Only the part of the shell that overlaps the occupied region.
+                const auto x_lo = std::max(-k, min_x_ - center.x);
+                const auto x_hi = std::min(k, max_x_ - center.x);
+                const auto y_lo = std::max(-k, min_y_ - center.y);
+                const auto y_hi = std::min(k, max_y_ - center.y);
+                const auto a_lo = std::max(-k, min_angle_offset());
+                const auto a_hi = std::min(k, max_angle_offset());
+                for(auto dx = x_lo; dx <= x_hi; dx++)
+                {
+                    for(auto dy = y_lo; dy <= y_hi; dy++)
+                    {
+                        const bool on_shell = std::max(std::abs(dx), std::abs(dy)) == k;
+                        for(auto da = a_lo; da <= a_hi; da++)
+                        {
+                            // Inside the shell only the two angle faces remain.
+                            if(!on_shell && std::abs(da) != k)
+                            {
+                                if(da < 0)
+                                    da = k - 1;     // Skip ahead to the positive face.
+                                continue;
+                            }
+
+                            const auto it = cells_.find(offset(center, dx, dy, da));
+                            if(it == cells_.end())
+                                continue;
+
+                            for(auto i : it->second)
+                            {
+                                const auto d = distance(entries_[i], t, angle);
+                                if(d < best_distance || (d == best_distance && best == npos))
+                                {
+                                    best_distance = d;
+                                    best = i;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        if(distance_out)
+            *distance_out = best_distance;
+        return best;
+    }
+
+private:
+    struct Entry
+    {
+        DualComplex<T> pose;
+        std::complex<T> translation;
+        T angle;
+    };
+
+    struct CellKey
+    {
+        long long x;
+        long long y;
+        long long a;
+
+        bool operator == (const CellKey& rhs) const noexcept
+        {
+            return x == rhs.x && y == rhs.y && a == rhs.a;
+        }
+    };
+
+    struct CellHash
+    {
+        std::size_t operator () (const CellKey& key) const noexcept
+        {
+            auto h = static_cast<std::uint64_t>(key.x) * 0x9e3779b97f4a7c15ull;
+            h ^= static_cast<std::uint64_t>(key.y) * 0xc2b2ae3d27d4eb4full + (h << 6) + (h >> 2);
+            h ^= static_cast<std::uint64_t>(key.a) * 0x165667b19e3779f9ull + (h << 6) + (h >> 2);
+            return static_cast<std::size_t>(h);
+        }
+    };
+
+    CellKey cell_of(const std::complex<T>& t, T angle) const
+    {
+        const auto pi = static_cast<T>(3.14159265358979323846);
+        auto a = static_cast<long long>(
+            std::floor((angle + pi) / (static_cast<T>(2) * pi) * static_cast<T>(angle_cells_)));
+        a = std::min(std::max(a, 0ll), angle_cells_ - 1);
+        const CellKey key = {
+            static_cast<long long>(std::floor(t.real() / cell_size_)),
+            static_cast<long long>(std::floor(t.imag() / cell_size_)),
+            a
+        };
+        return key;
+    }
+
+    CellKey offset(const CellKey& key, long long dx, long long dy, long long da) const
+    {
+        auto a = (key.a + da) % angle_cells_;
+        if(a < 0)
+            a += angle_cells_;
+        const CellKey res = { key.x + dx, key.y + dy, a };
+        return res;
+    }
+
+    /**
+     * Angular offsets are taken from [min_angle_offset(), max_angle_offset()] so that every cell
+     * around the circle is visited once.
+     */
+    long long min_angle_offset() const noexcept { return -((angle_cells_ - 1) / 2); }
+    long long max_angle_offset() const noexcept { return angle_cells_ / 2; }
+
+    T distance(const Entry& entry, const std::complex<T>& t, T angle) const
+    {
+        const auto da = angle_weight_ * detail::wrap_angle(entry.angle - angle);
+        return std::sqrt(std::norm(entry.translation - t) + da * da);
+    }
+
+    T cell_size_;
+    T angle_weight_;
+    long long angle_cells_;
+    T angle_cell_size_;
+    std::vector<Entry> entries_;
+    std::unordered_map<CellKey, std::vector<size_type>, CellHash> cells_;
+    long long min_x_ = 0;
+    long long max_x_ = 0;
+    long long min_y_ = 0;
+    long long max_y_ = 0;
+};
+
+template<typename T>
+constexpr typename PoseIndex<T>::size_type PoseIndex<T>::npos;
+
+}   // namespace dcn
@@ -0,0 +1,106 @@
+/**
+ * @file dualcomplex/dualcomplex_pose_interpolant.h
+ * @brief This file provides the building blocks shared by the interpolating lookups of timestamped poses.
+ */
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include "dualcomplex_transform.h"
+
+namespace dcn
+{
+
+namespace detail
+{
+
+/**
+ * Returns transformation_difference(p0, p1) with the sign of p1 chosen so that the rotation is at most half a turn,
+ * the difference that slerp_shortestpath(p0, p1, t) raises to the power t.
+ */
+template<typename T>
+DualComplex<T>
+shortest_difference(const DualComplex<T>& p0, const DualComplex<T>& p1)
+{
+    const auto dot = p0.real().real() * p1.real().real() + p0.real().imag() * p1.real().imag();
+    return transformation_difference(p0, (dot < static_cast<T>(0)) ? -p1 : p1);
+}
+
+/**
+ * Shortest-path screw interpolation between two unit poses, set up once and evaluated for many parameters.
+ * evaluate(t) equals slerp_shortestpath(p0, p1, t) with a single sine and cosine per call.
+ */
+template<typename T>
+class PoseInterpolant
+{
+public:
+    PoseInterpolant()
+        : p0_(static_cast<T>(1), static_cast<T>(0), static_cast<T>(0), static_cast<T>(0)),
+          angle_(static_cast<T>(0))
+    {}
+
+    PoseInterpolant(const DualComplex<T>& p0, const DualComplex<T>& p1)
+        : p0_(p0)
+    {
+        const auto diff = shortest_difference(p0, p1);
+        angle_ = std::arg(diff.real());
+        // pow(r, t - 1) = pow(r, t) * conj(r) for a unit r.
+        conj_real_dual_ = std::conj(diff.real()) * diff.dual();
+    }
+
+    DualComplex<T> evaluate(T t) const
+    {
+        const auto r = std::polar(static_cast<T>(1), t * angle_);
+        return p0_ * DualComplex<T>(r, t * r * conj_real_dual_);
+    }
+
+private:
+    DualComplex<T> p0_;
+    T angle_;
+    std::complex<T> conj_real_dual_;
+};
+
+/**
+ * Returns the segment i in [0, last] with times[i] <= time < times[i + 1], where the first and last segments
+ * extend to infinity, searching from the segment of a previous time.
+ *
+ * Later times gallop forward from the hint and earlier times bisect the segments before it,
+ * so that sorted times cost amortized O(1) each and any jump O(log(last)).
+ */
+template<typename T>
+std::size_t
+find_segment(const T* times, std::size_t last, std::size_t hint, T time)
+{
+    // times[lo] <= time < times[hi], with lo == 0 standing for -infinity and hi == last + 1 for +infinity.
+    std::size_t lo = 0;
+    auto hi = hint;
+    if(!(time < times[hint]))
+    {
+        lo = hint;
+        std::size_t step = 1;
+        hi = lo + step;
+        while(hi <= last && !(time < times[hi]))
+        {
+            lo = hi;
+            step *= 2;
+            hi = lo + step;
+        }
+        if(hi > last + 1)
+            hi = last + 1;
+    }
+
+    while(hi - lo > 1)
+    {
+        const auto mid = lo + (hi - lo) / 2;
+        if(time < times[mid])
+            hi = mid;
+        else
+            lo = mid;
+    }
+    return lo;
+}
+
+}   // namespace detail
+
+}   // namespace dcn
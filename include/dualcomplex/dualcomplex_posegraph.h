@@ -0,0 +1,401 @@
+/**
+ * @file dualcomplex/dualcomplex_posegraph.h
+ * @brief This file provides a 2D pose-graph optimizer for dual complex types.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+#include "dualcomplex_common.h"
+#include "dualcomplex_exponential.h"
+#include "dualcomplex_transform.h"
+#include "dualcomplex_jacobian.h"
+#include "dualcomplex_canonical.h"
+
+namespace dcn
+{
+
+/**
+ * Sparse nonlinear least-squares optimizer over unit dual complex poses.
+ *
+ * Each edge measures the relative pose transformation_difference(from, to), and its residual
+ * is vee(log(transformation_difference(measurement, transformation_difference(from, to)))).
+ * Edge Jacobians are cached and only recomputed when one of their nodes has moved by more
+ * than Options::relinearize_threshold since the last linearization.
+ */
+template<typename T>
+class PoseGraph
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using vector_type = Eigen::Matrix<T, 3, 1>;
+    using matrix_type = Eigen::Matrix<T, 3, 3>;
+
+    enum class Method
+    {
+        GaussNewton,
+        LevenbergMarquardt
+    };
+
+    struct Options
+    {
+        Method method = Method::LevenbergMarquardt;
+        int max_iterations = 20;
+        T relinearize_threshold = static_cast<T>(0);
+        T function_tolerance = static_cast<T>(1e-6);
+        T step_tolerance = static_cast<T>(1e-6);
+        T initial_lambda = static_cast<T>(1e-4);
+    };
+
+    struct Summary
+    {
+        int iterations = 0;
+        T initial_chi2 = static_cast<T>(0);
+        T final_chi2 = static_cast<T>(0);
+        bool converged = false;
+    };
+
+/* Constructors */
+    PoseGraph() = default;
+
+    /**
+     * Copies nodes and edges. The factorization is rebuilt on the next optimization.
+     */
+    PoseGraph(const PoseGraph& other)
+        : nodes_(other.nodes_), edges_(other.edges_)
+    {}
+
+/* Assignment operators */
+    PoseGraph& operator = (const PoseGraph& other)
+    {
+        nodes_ = other.nodes_;
+        edges_ = other.edges_;
+        structure_changed_ = true;
+        return *this;
+    }
+
+/* Modifiers */
+    /**
+     * Adds a node and returns its index.
+     */
+    size_type add_node(const DualComplex<T>& pose, bool fixed = false)
+    {
+        nodes_.push_back(Node{ pose, fixed, std::numeric_limits<T>::infinity() });
+        structure_changed_ = true;
+        return nodes_.size() - 1;
+    }
+
+    /**
+     * Adds a relative-pose constraint and returns its index.
+     */
+    size_type add_edge(
+        size_type from,
+        size_type to,
+        const DualComplex<T>& measurement,
+        const matrix_type& information = matrix_type::Identity())
+    {
+        assert(from < nodes_.size() && to < nodes_.size() && from != to);
+        edges_.push_back(Edge{ from, to, measurement, information, matrix_type::Zero(), matrix_type::Zero(), true });
+        structure_changed_ = true;
+        return edges_.size() - 1;
+    }
+
+    void set_pose(size_type index, const DualComplex<T>& pose)
+    {
+        nodes_[index].pose = pose;
+        nodes_[index].motion = std::numeric_limits<T>::infinity();
+    }
+
+    void set_fixed(size_type index, bool fixed)
+    {
+        nodes_[index].fixed = fixed;
+        structure_changed_ = true;
+    }
+
+/* Accessors */
+    const DualComplex<T>& pose(size_type index) const { return nodes_[index].pose; }
+    bool is_fixed(size_type index) const { return nodes_[index].fixed; }
+    size_type num_nodes() const noexcept { return nodes_.size(); }
+    size_type num_edges() const noexcept { return edges_.size(); }
+
+/* Operations */
+    /**
+     * Returns the residual of an edge.
+     */
+    vector_type residual(size_type index) const
+    {
+        const auto& edge = edges_[index];
+        return residual(edge, nodes_[edge.from].pose, nodes_[edge.to].pose);
+    }
+
+    /**
+     * Returns the sum of squared Mahalanobis residuals.
+     */
+    T chi2() const
+    {
+        auto res = static_cast<T>(0);
+        for(const auto& edge : edges_)
+        {
+            const auto e = residual(edge, nodes_[edge.from].pose, nodes_[edge.to].pose);
+            res += e.dot(edge.information * e);
+        }
+        return res;
+    }
+
+    /**
+     * Runs Gauss-Newton or Levenberg-Marquardt iterations.
+     * If no node is fixed, the first node is held fixed to remove the gauge freedom.
+     */
+    Summary optimize(const Options& options);
+
+    Summary optimize() { return optimize(Options()); }
+
+private:
+    struct Node
+    {
+        DualComplex<T> pose;
+        bool fixed;
+        T motion;   // Accumulated step norm since the last linearization.
+    };
+
+    struct Edge
+    {
+        size_type from;
+        size_type to;
+        DualComplex<T> measurement;
+        matrix_type information;
+        matrix_type jacobian_from;
+        matrix_type jacobian_to;
+        bool stale;
+    };
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    static DualComplex<T> error(const Edge& edge, const DualComplex<T>& from, const DualComplex<T>& to)
+    {
+        return canonicalize(transformation_difference(edge.measurement, transformation_difference(from, to)));
+    }
+
+    static vector_type residual(const Edge& edge, const DualComplex<T>& from, const DualComplex<T>& to)
+    {
+        return vee(log(error(edge, from, to)));
+    }
+
+    void update_variables();
+    void linearize(Edge& edge, T threshold);
+    void build_system(T lambda);
+
+    std::vector<Node> nodes_;
+    std::vector<Edge> edges_;
+    std::vector<size_type> variables_;  // Node index -> variable block index, or npos if fixed.
+    size_type num_variables_ = 0;
+    bool structure_changed_ = true;
+
+    std::vector<Eigen::Triplet<T>> triplets_;
+    Eigen::SparseMatrix<T> hessian_;
+    Eigen::Matrix<T, Eigen::Dynamic, 1> gradient_;
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<T>> solver_;
+};
+
+template<typename T>
+constexpr typename PoseGraph<T>::size_type PoseGraph<T>::npos;
+
+template<typename T>
+void
+PoseGraph<T>::update_variables()
+{
+    variables_.assign(nodes_.size(), npos);
+    num_variables_ = 0;
+
+    bool any_fixed = false;
+    for(const auto& node : nodes_)
+        any_fixed = any_fixed || node.fixed;
+
+    for(size_type i = 0; i < nodes_.size(); i++)
+    {
+        if(nodes_[i].fixed || (!any_fixed && i == 0))
+            continue;
+        variables_[i] = num_variables_++;
+    }
+}
+
+template<typename T>
+void
+PoseGraph<T>::linearize(Edge& edge, T threshold)
+{
+    const auto& from = nodes_[edge.from];
+    const auto& to = nodes_[edge.to];
+    if(!edge.stale && from.motion <= threshold && to.motion <= threshold)
+        return;
+
+    const auto e = residual(edge, from.pose, to.pose);
+    const matrix_type jr_inv = inverse_right_jacobian(e);
+    edge.jacobian_to = jr_inv;
+    edge.jacobian_from = -jr_inv * adjoint(transformation_difference(to.pose, from.pose));
+    edge.stale = false;
+}
+
+template<typename T>
+void
+PoseGraph<T>::build_system(T lambda)
+{
+    const auto size = static_cast<Eigen::Index>(3 * num_variables_);
+
+    triplets_.clear();
+    gradient_.setZero(size);
+
+    auto add_block = [this](size_type row, size_type col, const matrix_type& m)
+    {
+        for(int r = 0; r < 3; r++)
+            for(int c = 0; c < 3; c++)
+                triplets_.emplace_back(
+                    static_cast<int>(3 * row) + r, static_cast<int>(3 * col) + c, m(r, c));
+    };
+
+    for(const auto& edge : edges_)
+    {
+        const auto vi = variables_[edge.from];
+        const auto vj = variables_[edge.to];
+        if(vi == npos && vj == npos)
+            continue;
+
+        const auto e = residual(edge, nodes_[edge.from].pose, nodes_[edge.to].pose);
+        const vector_type we = edge.information * e;
+
+        if(vi != npos)
+        {
+            const matrix_type jt_w = edge.jacobian_from.transpose() * edge.information;
+            add_block(vi, vi, jt_w * edge.jacobian_from);
+            gradient_.template segment<3>(static_cast<Eigen::Index>(3 * vi))
+                += edge.jacobian_from.transpose() * we;
+            if(vj != npos)
+            {
+                const matrix_type hij = jt_w * edge.jacobian_to;
+                add_block(vi, vj, hij);
+                add_block(vj, vi, hij.transpose());
+            }
+        }
+        if(vj != npos)
+        {
+            add_block(vj, vj, edge.jacobian_to.transpose() * edge.information * edge.jacobian_to);
+            gradient_.template segment<3>(static_cast<Eigen::Index>(3 * vj))
+                += edge.jacobian_to.transpose() * we;
+        }
+    }
+
+    hessian_.resize(size, size);
+    hessian_.setFromTriplets(triplets_.begin(), triplets_.end());
+
+    if(lambda > static_cast<T>(0))
+    {
+        for(Eigen::Index i = 0; i < size; i++)
+            hessian_.coeffRef(i, i) *= static_cast<T>(1) + lambda;
+    }
+}
+
+template<typename T>
+typename PoseGraph<T>::Summary
+PoseGraph<T>::optimize(const Options& options)
+{
+    Summary summary;
+    summary.initial_chi2 = summary.final_chi2 = chi2();
+
+    if(structure_changed_)
+        update_variables();
+    if(num_variables_ == 0)
+    {
+        summary.converged = true;
+        return summary;
+    }
+
+    const bool use_lm = options.method == Method::LevenbergMarquardt;
+    auto lambda = use_lm ? options.initial_lambda : static_cast<T>(0);
+    auto current_chi2 = summary.initial_chi2;
+
+    std::vector<DualComplex<T>> backup(nodes_.size());
+    std::vector<T> motion(nodes_.size());
+
+    for(int iteration = 0; iteration < options.max_iterations; iteration++)
+    {
+        summary.iterations = iteration + 1;
+
+        for(auto& edge : edges_)
+            linearize(edge, options.relinearize_threshold);
+        for(auto& node : nodes_)
+        {
+            if(node.motion > options.relinearize_threshold)
+                node.motion = static_cast<T>(0);
+        }
+
+        build_system(lambda);
+        if(structure_changed_)
+        {
+            solver_.analyzePattern(hessian_);
+            structure_changed_ = false;
+        }
+        solver_.factorize(hessian_);
+        if(solver_.info() != Eigen::Success)
+            break;
+
+        const Eigen::Matrix<T, Eigen::Dynamic, 1> step = -solver_.solve(gradient_);
+        auto step_size = static_cast<T>(0);
+        for(Eigen::Index k = 0; k < step.size(); k++)
+            step_size = std::max(step_size, std::abs(step(k)));
+
+        for(size_type i = 0; i < nodes_.size(); i++)
+        {
+            backup[i] = nodes_[i].pose;
+            motion[i] = nodes_[i].motion;
+            const auto v = variables_[i];
+            if(v == npos)
+                continue;
+
+            const vector_type delta = step.template segment<3>(static_cast<Eigen::Index>(3 * v));
+            nodes_[i].pose = normalize(nodes_[i].pose * exp(hat(delta)));
+            nodes_[i].motion += delta.norm();
+        }
+
+        const auto new_chi2 = chi2();
+        if(new_chi2 > current_chi2)
+        {
+            for(size_type i = 0; i < nodes_.size(); i++)
+            {
+                nodes_[i].pose = backup[i];
+                nodes_[i].motion = motion[i];
+            }
+            // Gauss-Newton has no damping to retry with, so it stops at the last improving poses,
+            // which have only converged if the rejected step was negligible.
+            if(!use_lm)
+            {
+                summary.converged = step_size <= options.step_tolerance;
+                break;
+            }
+            lambda *= static_cast<T>(10);
+            continue;
+        }
+        if(use_lm)
+            lambda /= static_cast<T>(10);
+
+        const auto decrease = current_chi2 - new_chi2;
+        current_chi2 = new_chi2;
+        if(decrease <= options.function_tolerance * current_chi2
+        || step_size <= options.step_tolerance)
+        {
+            summary.converged = true;
+            break;
+        }
+    }
+
+    summary.final_chi2 = current_chi2;
+    return summary;
+}
+
+}   // namespace dcn
@@ -0,0 +1,197 @@
+/**
+ * @file dualcomplex/dualcomplex_random.h
+ * @brief This file provides reproducible batched sampling of random poses for dual complex types.
+ *
+ * Random numbers come from the counter-based Philox4x32-10 generator, so that the draws of
+ * every pose depend only on (seed, stream, index) and batches split across threads give the same result.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <Eigen/Core>
+#include "dualcomplex_soa.h"
+#include "dualcomplex_parallel.h"
+#include "dualcomplex_instrument.h"
+
+namespace dcn
+{
+
+namespace detail
+{
+
+/**
+ * Philox4x32-10 of Salmon et al., "Parallel random numbers: as easy as 1, 2, 3" (SC11).
+ * Maps a 128-bit counter and a 64-bit key to 128 random bits.
+ */
+inline void
+philox4x32_10(const std::uint32_t counter[4], const std::uint32_t key[2], std::uint32_t out[4])
+{
+    constexpr std::uint64_t m0 = 0xD2511F53u;
+    constexpr std::uint64_t m1 = 0xCD9E8D57u;
+    constexpr std::uint32_t w0 = 0x9E3779B9u;
+    constexpr std::uint32_t w1 = 0xBB67AE85u;
+
+    auto c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+    auto k0 = key[0], k1 = key[1];
+    for(int round = 0; round < 10; round++)
+    {
+        const auto p0 = m0 * c0;
+        const auto p1 = m1 * c2;
+        const auto hi0 = static_cast<std::uint32_t>(p0 >> 32);
+        const auto lo0 = static_cast<std::uint32_t>(p0);
+        const auto hi1 = static_cast<std::uint32_t>(p1 >> 32);
+        const auto lo1 = static_cast<std::uint32_t>(p1);
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = lo0;
+        k0 += w0;
+        k1 += w1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+/**
+ * Maps 32 random bits to a uniform number in (0, 1].
+ */
+template<typename T>
+T
+uniform_open(std::uint32_t bits)
+{
+    return (static_cast<T>(bits) + static_cast<T>(0.5)) * static_cast<T>(2.3283064365386962890625e-10);
+}
+
+/**
+ * Writes out[i] = load(i) * exp(hat(sigma * z_i)) for standard normal z_i.
+ *
+ * Each block first draws its random bits in one loop and then converts and composes them in a second,
+ * branch-free loop, so that the generator rounds are not interleaved with the transcendental calls and loads.
+ */
+template<typename T, typename Load>
+void
+perturb_poses(
+    std::size_t count,
+    Load load,
+    const Eigen::Matrix<T, 3, 1>& sigma,
+    std::uint64_t seed,
+    std::uint64_t stream,
+    T* rr,
+    T* ri,
+    T* dr,
+    T* di,
+    unsigned num_threads)
+{
+    DUALCOMPLEX_INSTRUMENT("perturb_poses", count);
+
+    const std::uint32_t key[2] = { static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) };
+    const auto sx = sigma(0);
+    const auto sy = sigma(1);
+    const auto half_stheta = static_cast<T>(0.5) * sigma(2);
+
+    parallel_for(count, num_threads,
+        [&](std::size_t begin, std::size_t end)
+        {
+            constexpr std::size_t block = 256;
+            constexpr auto two_pi = static_cast<T>(6.283185307179586476925286766559);
+            std::uint32_t bits[block][4];
+
+            for(auto base = begin; base < end; base += block)
+            {
+                const auto n = std::min(block, end - base);
+                for(std::size_t j = 0; j < n; j++)
+                {
+                    const auto i = static_cast<std::uint64_t>(base + j);
+                    const std::uint32_t counter[4] = {
+                        static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(i >> 32),
+                        static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)
+                    };
+                    philox4x32_10(counter, key, bits[j]);
+                }
+
+                for(std::size_t j = 0; j < n; j++)
+                {
+                    // Box-Muller: two normals from the first pair of uniforms and one from the second.
+                    const auto r0 = std::sqrt(static_cast<T>(-2) * std::log(uniform_open<T>(bits[j][0])));
+                    const auto a0 = two_pi * uniform_open<T>(bits[j][1]);
+                    const auto r1 = std::sqrt(static_cast<T>(-2) * std::log(uniform_open<T>(bits[j][2])));
+                    const auto a1 = two_pi * uniform_open<T>(bits[j][3]);
+                    const auto x = sx * r0 * std::cos(a0);
+                    const auto y = sy * r0 * std::sin(a0);
+                    const auto half_theta = half_stheta * r1 * std::cos(a1);
+
+                    // p * (e, e * (x + i y) / 2) with e = e^{i theta / 2}.
+                    T prr, pri, pdr, pdi;
+                    load(base + j, prr, pri, pdr, pdi);
+                    const auto er = std::cos(half_theta);
+                    const auto ei = std::sin(half_theta);
+                    const auto qr = prr * er - pri * ei;
+                    const auto qi = prr * ei + pri * er;
+                    const auto k = base + j;
+                    rr[k] = qr;
+                    ri[k] = qi;
+                    dr[k] = pdr * er + pdi * ei + static_cast<T>(0.5) * (qr * x - qi * y);
+                    di[k] = pdi * er - pdr * ei + static_cast<T>(0.5) * (qr * y + qi * x);
+                }
+            }
+        });
+}
+
+}   // namespace detail
+
+/**
+ * Fills out with mean * exp(hat(tau)), where the tangent vectors tau ordered as (x, y, theta)
+ * are independent zero-mean normals with the standard deviations sigma.
+ *
+ * Pose i depends only on seed, stream and i, so a filter can use one stream per step
+ * and get the same poses for any num_threads, 0 meaning all hardware threads.
+ */
+template<typename T, typename A>
+void
+sample_poses(
+    const DualComplex<T>& mean,
+    const Eigen::Matrix<T, 3, 1>& sigma,
+    std::uint64_t seed,
+    std::uint64_t stream,
+    DualComplexSoA<T, A>& out,
+    unsigned num_threads = 1)
+{
+    const auto mrr = mean.real().real();
+    const auto mri = mean.real().imag();
+    const auto mdr = mean.dual().real();
+    const auto mdi = mean.dual().imag();
+    detail::perturb_poses(out.size(),
+        [=](std::size_t, T& rr, T& ri, T& dr, T& di){ rr = mrr; ri = mri; dr = mdr; di = mdi; },
+        sigma, seed, stream, out.real_real(), out.real_imag(), out.dual_real(), out.dual_imag(), num_threads);
+}
+
+/**
+ * Writes out[i] = poses[i] * exp(hat(tau_i)), with tau_i distributed as in sample_poses().
+ * out is resized to poses and may be the same container.
+ */
+template<typename T, typename A1, typename A2>
+void
+perturb_poses(
+    const DualComplexSoA<T, A1>& poses,
+    const Eigen::Matrix<T, 3, 1>& sigma,
+    std::uint64_t seed,
+    std::uint64_t stream,
+    DualComplexSoA<T, A2>& out,
+    unsigned num_threads = 1)
+{
+    out.resize(poses.size());
+    const auto prr = poses.real_real();
+    const auto pri = poses.real_imag();
+    const auto pdr = poses.dual_real();
+    const auto pdi = poses.dual_imag();
+    detail::perturb_poses(poses.size(),
+        [=](std::size_t i, T& rr, T& ri, T& dr, T& di){ rr = prr[i]; ri = pri[i]; dr = pdr[i]; di = pdi[i]; },
+        sigma, seed, stream, out.real_real(), out.real_imag(), out.dual_real(), out.dual_imag(), num_threads);
+}
+
+}   // namespace dcn
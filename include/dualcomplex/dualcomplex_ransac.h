@@ -0,0 +1,339 @@
+/**
+ * @file dualcomplex/dualcomplex_ransac.h
+ * @brief This file provides robust pose estimation from point correspondences for dual complex types.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include "dualcomplex_transform.h"
+#include "dualcomplex_estimation.h"
+#include "dualcomplex_parallel.h"
+#include "dualcomplex_instrument.h"
+
+namespace dcn
+{
+
+/**
+ * Returns the transformation defined by two correspondences, src0 -> dst0 and src1 -> dst1.
+ */
+template<typename T>
+DualComplex<T>
+minimal_pose(
+    const std::complex<T>& src0,
+    const std::complex<T>& src1,
+    const std::complex<T>& dst0,
+    const std::complex<T>& dst1)
+{
+    const auto angle = std::arg(std::conj(src1 - src0) * (dst1 - dst0));
+    const auto half = static_cast<T>(0.5);
+    const auto d = half * (dst0 + dst1) - std::polar(static_cast<T>(1), angle) * (half * (src0 + src1));
+    return translation(d) * rotation(angle);
+}
+
+/**
+ * Counts, for every hypothesis, the correspondences whose residual is within the threshold.
+ *
+ * Hypotheses are expanded to their affine form once and scored as a tile against each point,
+ * with the inner loop running across the contiguous hypotheses of the tile.
+ */
+template<typename T>
+void
+score_hypotheses(
+    const DualComplex<T>* hypotheses,
+    std::size_t num_hypotheses,
+    const std::complex<T>* src,
+    const std::complex<T>* dst,
+    std::size_t count,
+    T threshold,
+    std::uint32_t* inliers)
+{
+    DUALCOMPLEX_INSTRUMENT("score_hypotheses", num_hypotheses * count);
+
+    constexpr std::size_t tile = 64;
+    T ar[tile], ai[tile], br[tile], bi[tile];
+    std::uint32_t counts[tile];
+
+    const auto squared_threshold = threshold * threshold;
+
+    for(std::size_t h0 = 0; h0 < num_hypotheses; h0 += tile)
+    {
+        const auto n = std::min(tile, num_hypotheses - h0);
+        for(std::size_t h = 0; h < n; h++)
+        {
+            const auto& p = hypotheses[h0 + h];
+            const auto a = p.real() * p.real();
+            const auto b = static_cast<T>(2) * p.real() * p.dual();
+            ar[h] = a.real();
+            ai[h] = a.imag();
+            br[h] = b.real();
+            bi[h] = b.imag();
+            counts[h] = 0;
+        }
+
+        for(std::size_t i = 0; i < count; i++)
+        {
+            const auto sx = src[i].real();
+            const auto sy = src[i].imag();
+            const auto dx = dst[i].real();
+            const auto dy = dst[i].imag();
+            for(std::size_t h = 0; h < n; h++)
+            {
+                const auto ex = ar[h] * sx - ai[h] * sy + br[h] - dx;
+                const auto ey = ai[h] * sx + ar[h] * sy + bi[h] - dy;
+                counts[h] += static_cast<std::uint32_t>(ex * ex + ey * ey <= squared_threshold);
+            }
+        }
+
+        std::copy(counts, counts + n, inliers + h0);
+    }
+}
+
+/**
+ * RANSAC and PROSAC estimation of a transformation from correspondences contaminated by outliers.
+ */
+template<typename T>
+class RansacPoseEstimator
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    enum class Sampling
+    {
+        Uniform,
+        Progressive     // PROSAC, correspondences must be sorted by decreasing quality.
+    };
+
+    struct Options
+    {
+        Sampling sampling = Sampling::Uniform;
+        T threshold = static_cast<T>(0.1);
+        T confidence = static_cast<T>(0.99);
+        size_type max_hypotheses = 10000;
+        size_type batch_size = 256;
+        unsigned num_threads = 1;
+        std::uint32_t seed = 5489u;
+        bool refine = true;
+    };
+
+    struct Result
+    {
+        DualComplex<T> transform;
+        std::vector<size_type> inliers;
+        size_type hypotheses = 0;
+        bool success = false;
+    };
+
+/* Operations */
+    static Result estimate(
+        const std::vector<std::complex<T>>& src,
+        const std::vector<std::complex<T>>& dst,
+        const Options& options);
+
+    static Result estimate(const std::vector<std::complex<T>>& src, const std::vector<std::complex<T>>& dst)
+    {
+        return estimate(src, dst, Options());
+    }
+
+private:
+    /**
+     * PROSAC sampling schedule for minimal samples of size two.
+     */
+    class ProgressiveSampler
+    {
+    public:
+        ProgressiveSampler(size_type count, size_type max_hypotheses)
+            : count_(count), n_(2), t_(0)
+        {
+            // T_n for n == m, scaled so that T_N == max_hypotheses.
+            tn_ = static_cast<double>(max_hypotheses);
+            for(size_type i = 0; i < 2; i++)
+                tn_ *= static_cast<double>(2 - i) / static_cast<double>(count - i);
+            tn_prime_ = 1;
+        }
+
+        template<typename Engine>
+        void sample(Engine& engine, size_type& i0, size_type& i1)
+        {
+            t_++;
+            if(t_ > tn_prime_ && n_ < count_)
+            {
+                const auto tn_next = tn_ * static_cast<double>(n_ + 1) / static_cast<double>(n_ + 1 - 2);
+                tn_prime_ += static_cast<size_type>(std::ceil(tn_next - tn_));
+                tn_ = tn_next;
+                n_++;
+            }
+
+            if(t_ <= tn_prime_)
+            {
+                // The newest correspondence plus one from the better ones.
+                std::uniform_int_distribution<size_type> dist(0, n_ - 2);
+                i0 = n_ - 1;
+                i1 = dist(engine);
+            }
+            else
+            {
+                std::uniform_int_distribution<size_type> dist(0, n_ - 1);
+                i0 = dist(engine);
+                i1 = dist(engine);
+            }
+        }
+
+    private:
+        size_type count_;
+        size_type n_;
+        size_type t_;
+        double tn_;
+        size_type tn_prime_;
+    };
+
+    static size_type required_hypotheses(T inlier_ratio, T confidence, size_type max_hypotheses)
+    {
+        const auto w2 = static_cast<double>(inlier_ratio) * static_cast<double>(inlier_ratio);
+        if(w2 >= 1.0)
+            return 0;
+        if(w2 <= 0.0)
+            return max_hypotheses;
+
+        const auto n = std::log(1.0 - static_cast<double>(confidence)) / std::log(1.0 - w2);
+        if(!(n < static_cast<double>(max_hypotheses)))
+            return max_hypotheses;
+        return static_cast<size_type>(std::ceil(n));
+    }
+};
+
+template<typename T>
+typename RansacPoseEstimator<T>::Result
+RansacPoseEstimator<T>::estimate(
+    const std::vector<std::complex<T>>& src,
+    const std::vector<std::complex<T>>& dst,
+    const Options& options)
+{
+    assert(src.size() == dst.size());
+
+    Result result;
+    const auto count = src.size();
+    if(count < 2)
+        return result;
+
+    std::mt19937 engine(options.seed);
+    std::uniform_int_distribution<size_type> uniform(0, count - 1);
+    ProgressiveSampler progressive(count, options.max_hypotheses);
+
+    const auto batch_size = std::max<size_type>(options.batch_size, 1);
+    const auto threads = static_cast<unsigned>(
+        std::min<size_type>(detail::resolve_num_threads(options.num_threads), batch_size));
+
+    std::vector<DualComplex<T>> hypotheses;
+    std::vector<std::uint32_t> scores;
+    hypotheses.reserve(batch_size);
+
+    std::uint32_t best_score = 0;
+    auto budget = options.max_hypotheses;
+
+    // The workers are spawned once. Thread zero generates each batch and applies the early termination
+    // between the barriers, while every thread scores its share of the batch.
+    detail::Barrier barrier(threads);
+    bool done = false;
+    detail::parallel_team(threads,
+        [&](unsigned thread, unsigned team)
+        {
+            for(;;)
+            {
+                if(thread == 0)
+                {
+                    done = !(result.hypotheses < budget);
+                    if(!done)
+                    {
+                        // Generate a batch of minimal-sample hypotheses.
+                        const auto n = std::min(batch_size, budget - result.hypotheses);
+                        hypotheses.clear();
+                        for(size_type k = 0; k < n; k++)
+                        {
+                            size_type i0 = 0;
+                            size_type i1 = 0;
+                            for(int attempt = 0; attempt < 16 && src[i0] == src[i1]; attempt++)
+                            {
+                                if(options.sampling == Sampling::Progressive)
+                                    progressive.sample(engine, i0, i1);
+                                else
+                                {
+                                    i0 = uniform(engine);
+                                    i1 = uniform(engine);
+                                }
+                            }
+                            hypotheses.push_back(minimal_pose(src[i0], src[i1], dst[i0], dst[i1]));
+                        }
+                        result.hypotheses += n;
+                        scores.resize(n);
+                    }
+                }
+                barrier.wait();
+                if(done)
+                    return;
+
+                // Score the batch, split across threads by hypotheses.
+                const auto n = hypotheses.size();
+                const auto begin = n * thread / team;
+                const auto end = n * (thread + 1) / team;
+                score_hypotheses(hypotheses.data() + begin, end - begin,
+                    src.data(), dst.data(), count, options.threshold, scores.data() + begin);
+                barrier.wait();
+
+                if(thread == 0)
+                {
+                    const auto best = std::max_element(scores.begin(), scores.end());
+                    if(*best > best_score)
+                    {
+                        best_score = *best;
+                        result.transform = hypotheses[static_cast<size_type>(best - scores.begin())];
+                        result.success = best_score >= 2;
+
+                        const auto ratio = static_cast<T>(best_score) / static_cast<T>(count);
+                        budget = std::min(budget, required_hypotheses(ratio, options.confidence, options.max_hypotheses));
+                    }
+                }
+            }
+        });
+
+    if(!result.success)
+        return result;
+
+    auto collect_inliers = [&](const DualComplex<T>& p)
+    {
+        const auto squared_threshold = options.threshold * options.threshold;
+        result.inliers.clear();
+        for(size_type i = 0; i < count; i++)
+        {
+            if(std::norm(transform(p, src[i]) - dst[i]) <= squared_threshold)
+                result.inliers.push_back(i);
+        }
+    };
+
+    collect_inliers(result.transform);
+    if(options.refine)
+    {
+        PoseFitAccumulator<T> acc;
+        for(auto i : result.inliers)
+            acc.add(src[i], dst[i]);
+        const auto refined = acc.estimate();
+
+        const auto size = result.inliers.size();
+        collect_inliers(refined);
+        if(result.inliers.size() >= size)
+            result.transform = refined;
+        else
+            collect_inliers(result.transform);
+    }
+    return result;
+}
+
+}   // namespace dcn
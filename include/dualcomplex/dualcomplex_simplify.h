@@ -0,0 +1,151 @@
+/**
+ * @file dualcomplex/dualcomplex_simplify.h
+ * @brief This file provides keyframe reduction of trajectories for dual complex types.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "dualcomplex_pose_interpolant.h"
+#include "dualcomplex_parallel.h"
+#include "dualcomplex_instrument.h"
+
+namespace dcn
+{
+
+template<typename T>
+struct SimplifyOptions
+{
+    T translation_tolerance = static_cast<T>(0.01);
+    T angle_tolerance = static_cast<T>(0.01);
+    std::size_t chunk_size = 4096;  // Poses per independently simplified chunk.
+    unsigned num_threads = 1;       // 0 uses all hardware threads.
+};
+
+namespace detail
+{
+
+/**
+ * Reduces the poses [first, last] by Douglas-Peucker and appends the kept indices but last, in order.
+ *
+ * The error of a pose is the larger of its translation and angle errors against the interpolation
+ * between the enclosing keys, each divided by its tolerance.
+ */
+template<typename T>
+void
+simplify_range(
+    const DualComplex<T>* poses,
+    const T* times,
+    std::size_t first,
+    std::size_t last,
+    const SimplifyOptions<T>& options,
+    std::vector<std::size_t>& keys)
+{
+    const auto scale = [](T tolerance)
+    {
+        return (tolerance > static_cast<T>(0)) ? static_cast<T>(1) / tolerance : std::numeric_limits<T>::max();
+    };
+    const auto translation_scale = scale(options.translation_tolerance);
+    const auto angle_scale = scale(options.angle_tolerance);
+
+    const auto begin = keys.size();
+    keys.push_back(first);
+
+    std::vector<std::pair<std::size_t, std::size_t>> stack;
+    stack.push_back(std::make_pair(first, last));
+    while(!stack.empty())
+    {
+        const auto a = stack.back().first;
+        const auto b = stack.back().second;
+        stack.pop_back();
+        if(b - a < 2)
+            continue;
+
+        const PoseInterpolant<T> interpolant(poses[a], poses[b]);
+        const auto t0 = times ? times[a] : static_cast<T>(a);
+        const auto inverse_duration = static_cast<T>(1) / ((times ? times[b] : static_cast<T>(b)) - t0);
+
+        auto worst = static_cast<T>(1);
+        auto split = a;
+        for(auto i = a + 1; i < b; i++)
+        {
+            const auto s = ((times ? times[i] : static_cast<T>(i)) - t0) * inverse_duration;
+            const auto approx = interpolant.evaluate(s);
+            const auto translation = static_cast<T>(2) * (poses[i].real() * poses[i].dual() - approx.real() * approx.dual());
+            const auto rotation = poses[i].real() * poses[i].real() * std::conj(approx.real() * approx.real());
+            const auto error = std::max(
+                std::abs(translation) * translation_scale,
+                std::abs(std::arg(rotation)) * angle_scale);
+            if(error > worst)
+            {
+                worst = error;
+                split = i;
+            }
+        }
+        if(split != a)
+        {
+            keys.push_back(split);
+            stack.push_back(std::make_pair(split, b));
+            stack.push_back(std::make_pair(a, split));
+        }
+    }
+    std::sort(keys.begin() + static_cast<std::ptrdiff_t>(begin), keys.end());
+}
+
+}   // namespace detail
+
+/**
+ * Returns the ascending indices of keyframes, including the first and last poses, such that interpolating
+ * every other unit pose with slerp_shortestpath between its enclosing keyframes stays within the tolerances.
+ *
+ * Poses are interpolated by their times, which must be strictly increasing, or by their indices if times is null.
+ * The trajectory is split into chunks of options.chunk_size poses whose ends are always kept,
+ * so that the chunks are reduced independently on options.num_threads threads and the result
+ * does not depend on the number of threads.
+ */
+template<typename T>
+std::vector<std::size_t>
+simplify_trajectory(
+    const DualComplex<T>* poses,
+    const T* times,
+    std::size_t count,
+    const SimplifyOptions<T>& options = SimplifyOptions<T>())
+{
+    assert(options.chunk_size > 0);
+    assert(!times || std::adjacent_find(times, times + count, [](T lhs, T rhs){ return !(lhs < rhs); }) == times + count);
+    DUALCOMPLEX_INSTRUMENT("simplify_trajectory", count);
+
+    std::vector<std::size_t> res;
+    if(count <= 2)
+    {
+        for(std::size_t i = 0; i < count; i++)
+            res.push_back(i);
+        return res;
+    }
+
+    const auto num_chunks = (count - 2) / options.chunk_size + 1;
+    std::vector<std::vector<std::size_t>> chunk_keys(num_chunks);
+    detail::parallel_for(num_chunks, options.num_threads,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for(auto c = begin; c < end; c++)
+            {
+                const auto first = c * options.chunk_size;
+                const auto last = std::min(first + options.chunk_size, count - 1);
+                detail::simplify_range(poses, times, first, last, options, chunk_keys[c]);
+            }
+        });
+
+    for(const auto& keys : chunk_keys)
+        res.insert(res.end(), keys.begin(), keys.end());
+    res.push_back(count - 1);
+    return res;
+}
+
+}   // namespace dcn
@@ -0,0 +1,164 @@
+/**
+ * @file dualcomplex/dualcomplex_soa.h
+ * @brief This file provides a structure-of-arrays container for dual complex types.
+ */
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "dualcomplex_base.h"
+
+namespace dcn
+{
+
+template<typename E>
+class SoAExpression;
+
+/**
+ * Stores dual complex numbers as four separate component arrays,
+ * real().real(), real().imag(), dual().real() and dual().imag(), so that bulk kernels vectorize.
+ * Each array is allocated with Allocator, e.g. an ArenaAllocator from dualcomplex_allocator.h.
+ */
+template<typename T, typename Allocator = std::allocator<T>>
+class DualComplexSoA
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using allocator_type = Allocator;
+
+/* Constructors */
+    DualComplexSoA() = default;
+    DualComplexSoA(const DualComplexSoA&) = default;
+    DualComplexSoA(DualComplexSoA&&) = default;
+
+    explicit DualComplexSoA(const Allocator& alloc)
+        : rr_(alloc), ri_(alloc), dr_(alloc), di_(alloc)
+    {}
+
+    explicit DualComplexSoA(size_type count, const Allocator& alloc = Allocator())
+        : rr_(count, T(), alloc), ri_(count, T(), alloc), dr_(count, T(), alloc), di_(count, T(), alloc)
+    {}
+
+    DualComplexSoA(const DualComplex<T>* dcs, size_type count, const Allocator& alloc = Allocator())
+        : DualComplexSoA(count, alloc)
+    {
+        for(size_type i = 0; i < count; i++)
+            set(i, dcs[i]);
+    }
+
+    template<typename A>
+    explicit DualComplexSoA(const std::vector<DualComplex<T>, A>& dcs, const Allocator& alloc = Allocator())
+        : DualComplexSoA(dcs.data(), dcs.size(), alloc)
+    {}
+
+    /**
+     * Evaluates an expression from dualcomplex_expression.h.
+     */
+    template<typename E>
+    DualComplexSoA(const SoAExpression<E>& expr, const Allocator& alloc = Allocator())
+        : DualComplexSoA(alloc)
+    {
+        *this = expr;
+    }
+
+/* Assignment operators */
+    DualComplexSoA& operator = (const DualComplexSoA&) = default;
+    DualComplexSoA& operator = (DualComplexSoA&&) = default;
+
+    /**
+     * Evaluates an expression in a single pass.
+     * The expression may refer to this container as long as its size does not change.
+     */
+    template<typename E>
+    DualComplexSoA& operator = (const SoAExpression<E>& expr)
+    {
+        const auto& e = expr.derived();
+        resize(e.size());
+        for(size_type i = 0; i < size(); i++)
+        {
+            const auto dc = e[i];
+            rr_[i] = dc.real().real();
+            ri_[i] = dc.real().imag();
+            dr_[i] = dc.dual().real();
+            di_[i] = dc.dual().imag();
+        }
+        return *this;
+    }
+
+/* Accessors */
+    allocator_type get_allocator() const { return rr_.get_allocator(); }
+
+    size_type size() const noexcept { return rr_.size(); }
+    bool empty() const noexcept { return rr_.empty(); }
+
+    const T* real_real() const noexcept { return rr_.data(); }
+    const T* real_imag() const noexcept { return ri_.data(); }
+    const T* dual_real() const noexcept { return dr_.data(); }
+    const T* dual_imag() const noexcept { return di_.data(); }
+
+    T* real_real() noexcept { return rr_.data(); }
+    T* real_imag() noexcept { return ri_.data(); }
+    T* dual_real() noexcept { return dr_.data(); }
+    T* dual_imag() noexcept { return di_.data(); }
+
+    DualComplex<T> get(size_type i) const
+    {
+        assert(i < size());
+        return DualComplex<T>(rr_[i], ri_[i], dr_[i], di_[i]);
+    }
+
+    DualComplex<T> operator [] (size_type i) const { return get(i); }
+
+/* Modifiers */
+    void set(size_type i, const DualComplex<T>& dc)
+    {
+        assert(i < size());
+        rr_[i] = dc.real().real();
+        ri_[i] = dc.real().imag();
+        dr_[i] = dc.dual().real();
+        di_[i] = dc.dual().imag();
+    }
+
+    void push_back(const DualComplex<T>& dc)
+    {
+        rr_.push_back(dc.real().real());
+        ri_.push_back(dc.real().imag());
+        dr_.push_back(dc.dual().real());
+        di_.push_back(dc.dual().imag());
+    }
+
+    void resize(size_type count)
+    {
+        rr_.resize(count);
+        ri_.resize(count);
+        dr_.resize(count);
+        di_.resize(count);
+    }
+
+    void reserve(size_type count)
+    {
+        rr_.reserve(count);
+        ri_.reserve(count);
+        dr_.reserve(count);
+        di_.reserve(count);
+    }
+
+    void clear() noexcept
+    {
+        rr_.clear();
+        ri_.clear();
+        dr_.clear();
+        di_.clear();
+    }
+
+private:
+    std::vector<T, Allocator> rr_;
+    std::vector<T, Allocator> ri_;
+    std::vector<T, Allocator> dr_;
+    std::vector<T, Allocator> di_;
+};
+
+}   // namespace dcn
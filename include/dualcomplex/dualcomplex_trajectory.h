@@ -0,0 +1,100 @@
+/**
+ * @file dualcomplex/dualcomplex_trajectory.h
+ * @brief This file provides dense sampling of screw motions for dual complex types.
+ */
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include "dualcomplex_common.h"
+#include "dualcomplex_transform.h"
+#include "dualcomplex_instrument.h"
+
+namespace dcn
+{
+
+/**
+ * Returns the step s of the screw motion along a unit transformation, such that s^steps == dc.
+ *
+ * The motion turns by the angle of dc, taken in (-pi, pi], at a constant rate about a fixed center,
+ * or translates at a constant rate if dc is a pure translation.
+ * Unlike pow(dc, 1 / steps), repeated products of the step stay on this motion.
+ */
+template<typename T>
+DualComplex<T>
+screw_root(const DualComplex<T>& dc, std::size_t steps)
+{
+    assert(steps > 0);
+
+    // The sign of dc that gives the shortest rotation.
+    const auto p = (dc.real().real() < static_cast<T>(0)) ? -dc : dc;
+    const auto n = static_cast<T>(steps);
+    const auto half_angle = std::arg(p.real());
+    const auto translation = static_cast<T>(2) * p.real() * p.dual();
+
+    // The translation t_s of the step satisfies (1 + R_s + ... + R_s^(n - 1)) t_s = t, so that
+    // t_s = (1 - R_s) / (1 - R) t = e^(i (half_angle / n - half_angle)) sin(half_angle / n) / sin(half_angle) t.
+    const auto step_half_angle = half_angle / n;
+    const auto denominator = std::sin(half_angle);
+    const auto ratio = (std::abs(denominator) > std::numeric_limits<T>::epsilon())
+        ? std::polar(std::sin(step_half_angle) / denominator, step_half_angle - half_angle)
+        : std::complex<T>(static_cast<T>(1) / n, static_cast<T>(0));
+    const auto step_translation = ratio * translation;
+
+    const auto r = std::polar(static_cast<T>(1), step_half_angle);
+    return DualComplex<T>(r, std::conj(r) * step_translation / static_cast<T>(2));
+}
+
+/**
+ * Writes steps + 1 evenly spaced poses of the screw motion from dc0 to dc1, out[0] = dc0 and out[steps] = dc1
+ * up to sign, where both are unit.
+ *
+ * Each pose is the previous one multiplied by screw_root(transformation_difference(dc0, dc1), steps),
+ * renormalized every renormalize_interval steps.
+ */
+template<typename T>
+void
+sample_screw(
+    const DualComplex<T>& dc0,
+    const DualComplex<T>& dc1,
+    std::size_t steps,
+    DualComplex<T>* out,
+    std::size_t renormalize_interval = 16)
+{
+    assert(steps > 0);
+    assert(renormalize_interval > 0);
+    DUALCOMPLEX_INSTRUMENT("sample_screw", steps + 1);
+
+    const auto step = screw_root(transformation_difference(dc0, dc1), steps);
+
+    auto pose = dc0;
+    out[0] = pose;
+    for(std::size_t k = 1; k <= steps; k++)
+    {
+        pose *= step;
+        if(k % renormalize_interval == 0)
+            pose = normalize(pose);
+        out[k] = pose;
+    }
+}
+
+/**
+ * Transforms a footprint by every pose, out[i * num_points + j] = transform(poses[i], footprint[j]).
+ */
+template<typename T>
+void
+transform_footprint(
+    const DualComplex<T>* poses,
+    std::size_t num_poses,
+    const std::complex<T>* footprint,
+    std::size_t num_points,
+    std::complex<T>* out)
+{
+    for(std::size_t i = 0; i < num_poses; i++)
+        transform(poses[i], footprint, num_points, out + i * num_points);
+}
+
+}   // namespace dcn
@@ -5,7 +5,9 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 #include "dualcomplex_common.h"
+#include "dualcomplex_instrument.h"
 
 namespace dcn
 {
@@ -17,9 +19,12 @@ template<typename T>
 DualComplex<T>
 rotation(T angle)
 {
+    using std::cos;
+    using std::sin;
+
     const auto half_angle = angle / static_cast<T>(2);
     return DualComplex<T>(
-        std::complex<T>(std::cos(half_angle), std::sin(half_angle)),
+        std::complex<T>(cos(half_angle), sin(half_angle)),
         std::complex<T>(static_cast<T>(0), static_cast<T>(0)));
 }
 
@@ -47,6 +52,31 @@ transform(const DualComplex<T>& p, const std::complex<T>& v)
 #endif
 }
 
+/**
+ * Transform vectors with a dual complex number.
+ * The transformation is expanded once and applied with real arithmetic so that the loop vectorizes.
+ */
+template<typename T>
+void
+transform(const DualComplex<T>& p, const std::complex<T>* v, std::size_t count, std::complex<T>* out)
+{
+    DUALCOMPLEX_INSTRUMENT("transform_bulk", count);
+
+    const auto a = p.real() * p.real();
+    const auto b = static_cast<T>(2) * p.real() * p.dual();
+    const auto ar = a.real();
+    const auto ai = a.imag();
+    const auto br = b.real();
+    const auto bi = b.imag();
+
+    for(std::size_t i = 0; i < count; i++)
+    {
+        const auto x = v[i].real();
+        const auto y = v[i].imag();
+        out[i] = std::complex<T>(ar * x - ai * y + br, ai * x + ar * y + bi);
+    }
+}
+
 /**
  * Difference between two transformations.
  */
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <complex>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include "gtest_helper.h"
+
+namespace pose_helper
+{
+
+/**
+ * Returns the pose that rotates by angle and then translates by (x, y).
+ */
+template<typename T>
+dcn::DualComplex<T> make_pose(T x, T y, T angle)
+{
+    return dcn::translation(std::complex<T>(x, y)) * dcn::rotation(angle);
+}
+
+/**
+ * Compares the actions of two poses, which are equal up to sign.
+ */
+template<typename T>
+void expect_same_motion(const dcn::DualComplex<T>& lhs, const dcn::DualComplex<T>& rhs, T tolerance)
+{
+    const std::complex<T> points[3] = { std::complex<T>(0, 0), std::complex<T>(1, 0), std::complex<T>(0, 1) };
+    for(const auto& p : points)
+        EXPECT_COMPLEX_ALMOST_EQUAL(dcn::transform(lhs, p), dcn::transform(rhs, p), tolerance);
+}
+
+}   // namespace pose_helper
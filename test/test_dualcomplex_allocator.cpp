@@ -0,0 +1,197 @@
+#include <cstdint>
+#include <thread>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_interpolation.h>
+#include <dualcomplex/dualcomplex_expression.h>
+#include <dualcomplex/dualcomplex_batch_query.h>
+#include <dualcomplex/dualcomplex_allocator.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+bool
+is_aligned(const void* p, std::size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+template<typename T>
+class DualComplexAllocatorTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    static dcn::DualComplex<T> make_value(std::size_t i)
+    {
+        const auto x = static_cast<T>(i) * T(0.1);
+        return dcn::translation(std::complex<T>(x, T(1) - x)) * dcn::rotation(x);
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexAllocatorTest, MyTypes);
+
+TEST(FrameArenaTest, allocate_and_reset)
+{
+    dcn::FrameArena arena(256);
+    EXPECT_EQ(arena.capacity(), 256u);
+    EXPECT_EQ(arena.used(), 0u);
+
+    const auto p0 = arena.allocate(3, 1);
+    const auto p1 = arena.allocate(64, 64);
+    EXPECT_TRUE(is_aligned(p1, 64));
+    EXPECT_NE(p0, p1);
+    EXPECT_GE(arena.used(), 67u);
+
+    // Exceeds the first block.
+    const auto p2 = arena.allocate(1000, 32);
+    EXPECT_TRUE(is_aligned(p2, 32));
+    EXPECT_GT(arena.capacity(), 256u);
+
+    // The blocks are merged, so that the same frame no longer grows the arena.
+    arena.reset();
+    const auto capacity = arena.capacity();
+    EXPECT_GE(capacity, 1256u);
+    EXPECT_EQ(arena.used(), 0u);
+    arena.allocate(3, 1);
+    arena.allocate(64, 64);
+    arena.allocate(1000, 32);
+    EXPECT_EQ(arena.capacity(), capacity);
+}
+
+TEST(PoolAllocatorTest, reuse)
+{
+    dcn::release_thread_pool();
+
+    dcn::PoolAllocator<double> alloc;
+    const auto p0 = alloc.allocate(100);
+    EXPECT_TRUE(is_aligned(p0, 64));
+    alloc.deallocate(p0, 100);
+
+    // Same size class.
+    const auto p1 = alloc.allocate(90);
+    EXPECT_EQ(p1, p0);
+    alloc.deallocate(p1, 90);
+
+    // Several free blocks of one class, returned last in first out.
+    static_assert(noexcept(alloc.deallocate(p1, 90)), "deallocate must not throw.");
+    const auto q0 = alloc.allocate(8);
+    const auto q1 = alloc.allocate(8);
+    alloc.deallocate(q0, 8);
+    alloc.deallocate(q1, 8);
+    EXPECT_EQ(alloc.allocate(8), q1);
+    EXPECT_EQ(alloc.allocate(8), q0);
+    alloc.deallocate(q0, 8);
+    alloc.deallocate(q1, 8);
+
+    // Larger than the biggest class.
+    const std::size_t large = (1u << 22) + 1;
+    const auto p2 = alloc.allocate(large);
+    EXPECT_TRUE(is_aligned(p2, 64));
+    alloc.deallocate(p2, large);
+
+    dcn::release_thread_pool();
+}
+
+TEST(PoolAllocatorTest, threads)
+{
+    std::vector<std::thread> threads;
+    std::vector<int> results(4, 0);
+    for(std::size_t t = 0; t < results.size(); t++)
+    {
+        threads.emplace_back([t, &results]()
+        {
+            for(int frame = 0; frame < 100; frame++)
+            {
+                dcn::PoolVector<int> values;
+                for(int i = 0; i < 1000; i++)
+                    values.push_back(i);
+                results[t] += values.back();
+            }
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    for(auto r : results)
+        EXPECT_EQ(r, 99900);
+}
+
+TYPED_TEST(DualComplexAllocatorTest, arena_vector)
+{
+    using T = TypeParam;
+    using DC = dcn::DualComplex<T>;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    dcn::FrameArena arena(1024);
+    for(int frame = 0; frame < 3; frame++)
+    {
+        {
+            dcn::ArenaVector<DC> transforms{ dcn::ArenaAllocator<DC>(arena) };
+            dcn::ArenaVector<T> weights{ dcn::ArenaAllocator<T>(arena) };
+            std::vector<DC> expected_transforms;
+            std::vector<T> expected_weights;
+            for(std::size_t i = 0; i < 100; i++)
+            {
+                transforms.push_back(TestFixture::make_value(i));
+                weights.push_back(static_cast<T>(i % 7));
+                expected_transforms.push_back(transforms.back());
+                expected_weights.push_back(weights.back());
+            }
+            EXPECT_TRUE(is_aligned(transforms.data(), 64));
+
+            const auto res = dcn::dlb(transforms, weights);
+            const auto expected = dcn::dlb(expected_transforms, expected_weights);
+            EXPECT_COMPLEX_ALMOST_EQUAL(res.real(), expected.real(), atol);
+            EXPECT_COMPLEX_ALMOST_EQUAL(res.dual(), expected.dual(), atol);
+        }
+        arena.reset();
+    }
+}
+
+TYPED_TEST(DualComplexAllocatorTest, arena_soa)
+{
+    using T = TypeParam;
+    using SoA = dcn::DualComplexSoA<T, dcn::ArenaAllocator<T>>;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    dcn::FrameArena arena;
+    const dcn::ArenaAllocator<T> alloc(arena);
+
+    std::vector<dcn::DualComplex<T>> values;
+    for(std::size_t i = 0; i < 70; i++)
+        values.push_back(TestFixture::make_value(i));
+
+    const SoA a(values, alloc);
+    EXPECT_EQ(a.get_allocator(), alloc);
+    EXPECT_TRUE(is_aligned(a.real_real(), 64));
+    EXPECT_TRUE(is_aligned(a.dual_imag(), 64));
+
+    SoA b(alloc);
+    b = dcn::lazy(a) * dcn::lazy(a);
+    const SoA c(-dcn::lazy(b), alloc);
+    ASSERT_EQ(c.size(), values.size());
+    for(std::size_t i = 0; i < values.size(); i++)
+    {
+        const auto expected = -(values[i] * values[i]);
+        EXPECT_COMPLEX_ALMOST_EQUAL(c[i].real(), expected.real(), atol);
+        EXPECT_COMPLEX_ALMOST_EQUAL(c[i].dual(), expected.dual(), atol);
+    }
+
+    // Mixed allocators.
+    const dcn::DualComplexSoA<T> d(values);
+    EXPECT_EQ(dcn::batch_almost_equal(a, d, atol, nullptr), values.size());
+    EXPECT_EQ(dcn::batch_is_unit(a, atol, nullptr), values.size());
+}
+
+}   // namespace
@@ -0,0 +1,166 @@
+#include <random>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_query.h>
+#include <dualcomplex/dualcomplex_batch_query.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexBatchQueryTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    /**
+     * A mix of zeros, identities, unit and non-unit values, with sizes crossing mask words.
+     */
+    static std::vector<dcn::DualComplex<T>> make_values(std::size_t count, std::uint32_t seed)
+    {
+        using C = std::complex<T>;
+        std::mt19937 engine(seed);
+        std::uniform_real_distribution<T> dist(T(-3), T(3));
+
+        std::vector<dcn::DualComplex<T>> dcs;
+        for(std::size_t i = 0; i < count; i++)
+        {
+            const auto x = dist(engine);
+            const auto y = dist(engine);
+            switch(i % 5)
+            {
+            case 0: dcs.push_back(dcn::DualComplex<T>(C(T(0)), C(T(0)))); break;
+            case 1: dcs.push_back(dcn::DualComplex<T>(C(T(1)), C(T(0)))); break;
+            case 2: dcs.push_back(dcn::translation(C(x, y)) * dcn::rotation(x)); break;
+            case 3: dcs.push_back(dcn::DualComplex<T>(C(x, y), C(y, x))); break;
+            default: dcs.push_back(dcn::rotation(y)); break;
+            }
+        }
+        return dcs;
+    }
+
+    static bool test_bit(const std::vector<std::uint64_t>& mask, std::size_t i)
+    {
+        return ((mask[i / 64] >> (i % 64)) & 1u) != 0;
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexBatchQueryTest, MyTypes);
+
+TYPED_TEST(DualComplexBatchQueryTest, find_first_unset)
+{
+    std::vector<std::uint64_t> mask(dcn::mask_words(150), ~std::uint64_t(0));
+    EXPECT_EQ(std::size_t(150), dcn::find_first_unset(mask.data(), 150));
+
+    mask[1] &= ~(std::uint64_t(1) << 37);
+    EXPECT_EQ(std::size_t(101), dcn::find_first_unset(mask.data(), 150));
+
+    mask[0] &= ~(std::uint64_t(1) << 63);
+    EXPECT_EQ(std::size_t(63), dcn::find_first_unset(mask.data(), 150));
+
+    EXPECT_EQ(std::size_t(0), dcn::find_first_unset(mask.data(), 0));
+}
+
+TYPED_TEST(DualComplexBatchQueryTest, unary)
+{
+    using Fixture = DualComplexBatchQueryTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto dcs = Fixture::make_values(150, 1);
+    const dcn::DualComplexSoA<TypeParam> soa(dcs);
+
+    std::vector<std::uint64_t> zero(dcn::mask_words(dcs.size()));
+    std::vector<std::uint64_t> identity(dcn::mask_words(dcs.size()));
+    std::vector<std::uint64_t> unit(dcn::mask_words(dcs.size()));
+    const auto num_zero = dcn::batch_almost_zero(dcs.data(), dcs.size(), atol, zero.data());
+    const auto num_identity = dcn::batch_is_identity(dcs.data(), dcs.size(), atol, identity.data());
+    const auto num_unit = dcn::batch_is_unit(dcs.data(), dcs.size(), atol, unit.data());
+
+    std::size_t expected_zero = 0;
+    std::size_t expected_identity = 0;
+    std::size_t expected_unit = 0;
+    for(std::size_t i = 0; i < dcs.size(); i++)
+    {
+        EXPECT_EQ(almost_zero(dcs[i], atol), Fixture::test_bit(zero, i));
+        EXPECT_EQ(is_identity(dcs[i], atol), Fixture::test_bit(identity, i));
+        EXPECT_EQ(is_unit(dcs[i], atol), Fixture::test_bit(unit, i));
+        expected_zero += almost_zero(dcs[i], atol) ? 1u : 0u;
+        expected_identity += is_identity(dcs[i], atol) ? 1u : 0u;
+        expected_unit += is_unit(dcs[i], atol) ? 1u : 0u;
+    }
+    EXPECT_EQ(expected_zero, num_zero);
+    EXPECT_EQ(expected_identity, num_identity);
+    EXPECT_EQ(expected_unit, num_unit);
+    // Bits past the end are clear.
+    EXPECT_EQ(std::uint64_t(0), unit.back() >> (dcs.size() % 64));
+
+    std::vector<std::uint64_t> res(dcn::mask_words(soa.size()));
+    EXPECT_EQ(num_zero, dcn::batch_almost_zero(soa, atol, res.data()));
+    EXPECT_EQ(zero, res);
+    EXPECT_EQ(num_identity, dcn::batch_is_identity(soa, atol, res.data()));
+    EXPECT_EQ(identity, res);
+    EXPECT_EQ(num_unit, dcn::batch_is_unit(soa, atol, res.data()));
+    EXPECT_EQ(unit, res);
+
+    // Count only.
+    EXPECT_EQ(num_unit, dcn::batch_is_unit(dcs.data(), dcs.size(), atol, nullptr));
+}
+
+TYPED_TEST(DualComplexBatchQueryTest, binary)
+{
+    using DC = dcn::DualComplex<TypeParam>;
+    using Fixture = DualComplexBatchQueryTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto lhs = Fixture::make_values(150, 2);
+    auto rhs = Fixture::make_values(150, 3);
+    for(std::size_t i = 0; i < rhs.size(); i += 3)
+        rhs[i] = lhs[i];
+    for(std::size_t i = 1; i < rhs.size(); i += 7)
+        rhs[i] = -lhs[i];
+    const dcn::DualComplexSoA<TypeParam> lhs_soa(lhs);
+    const dcn::DualComplexSoA<TypeParam> rhs_soa(rhs);
+
+    std::vector<std::uint64_t> equal(dcn::mask_words(lhs.size()));
+    std::vector<std::uint64_t> same(dcn::mask_words(lhs.size()));
+    const auto num_equal = dcn::batch_almost_equal(lhs.data(), rhs.data(), lhs.size(), atol, equal.data());
+    const auto num_same = dcn::batch_are_same(lhs.data(), rhs.data(), lhs.size(), atol, same.data());
+
+    std::size_t expected_equal = 0;
+    std::size_t expected_same = 0;
+    for(std::size_t i = 0; i < lhs.size(); i++)
+    {
+        const auto expected = almost_equal(lhs[i], rhs[i], atol) || almost_equal(lhs[i], DC(-rhs[i]), atol);
+        if(is_unit(lhs[i], atol) && is_unit(rhs[i], atol))
+        {
+            EXPECT_EQ(are_same(lhs[i], rhs[i], atol), expected);
+        }
+        EXPECT_EQ(almost_equal(lhs[i], rhs[i], atol), Fixture::test_bit(equal, i));
+        EXPECT_EQ(expected, Fixture::test_bit(same, i));
+        expected_equal += almost_equal(lhs[i], rhs[i], atol) ? 1u : 0u;
+        expected_same += expected ? 1u : 0u;
+    }
+    EXPECT_EQ(expected_equal, num_equal);
+    EXPECT_EQ(expected_same, num_same);
+    EXPECT_EQ(std::size_t(1), dcn::find_first_unset(equal.data(), lhs.size()));
+
+    std::vector<std::uint64_t> res(dcn::mask_words(lhs_soa.size()));
+    EXPECT_EQ(num_equal, dcn::batch_almost_equal(lhs_soa, rhs_soa, atol, res.data()));
+    EXPECT_EQ(equal, res);
+    EXPECT_EQ(num_same, dcn::batch_are_same(lhs_soa, rhs_soa, atol, res.data()));
+    EXPECT_EQ(same, res);
+}
+
+}   // namespace
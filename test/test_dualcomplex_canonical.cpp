@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_query.h>
+#include <dualcomplex/dualcomplex_canonical.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexCanonicalTest
+    : public ::testing::Test
+{
+protected:
+    static const T PI;
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+};
+
+template<typename T>
+const T
+DualComplexCanonicalTest<T>::PI = std::acos(-T(1));
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexCanonicalTest, MyTypes);
+
+TYPED_TEST(DualComplexCanonicalTest, canonicalize)
+{
+    using C = std::complex<TypeParam>;
+    using DC = dcn::DualComplex<TypeParam>;
+    using Fixture = DualComplexCanonicalTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    for(int i = -8; i <= 8; i++)
+    {
+        const auto angle = Fixture::PI * TypeParam(i) / TypeParam(4);
+        const auto p = dcn::translation(C(TypeParam(1), TypeParam(-2))) * dcn::rotation(angle);
+        const auto a = dcn::canonicalize(p);
+        const auto b = dcn::canonicalize(DC(-p));
+
+        EXPECT_TRUE(dcn::is_canonical(a));
+        EXPECT_TRUE(are_same(p, a, atol));
+        EXPECT_EQ(a.real(), b.real());
+        EXPECT_EQ(a.dual(), b.dual());
+    }
+    {
+        // Half turn, the real part of the real part is zero.
+        const auto p = DC(C(TypeParam(0), TypeParam(-1)), C(TypeParam(1), TypeParam(2)));
+        EXPECT_FALSE(dcn::is_canonical(p));
+        EXPECT_TRUE(dcn::is_canonical(dcn::canonicalize(p)));
+        EXPECT_TRUE(dcn::is_canonical(DC(-p)));
+    }
+}
+
+TYPED_TEST(DualComplexCanonicalTest, composition)
+{
+    using C = std::complex<TypeParam>;
+    using DC = dcn::DualComplex<TypeParam>;
+    using CDC = dcn::CanonicalDualComplex<TypeParam>;
+    using Fixture = DualComplexCanonicalTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto p = dcn::translation(C(TypeParam(1), TypeParam(2))) * dcn::rotation(TypeParam(2.5));
+    const auto q = dcn::translation(C(TypeParam(-3), TypeParam(1))) * dcn::rotation(TypeParam(1.5));
+
+    const CDC cp(p);
+    const CDC cq(DC(-q));
+    const auto res = cp * cq;
+    EXPECT_TRUE(dcn::is_canonical(res.value()));
+    EXPECT_TRUE(are_same(p * q, res.value(), atol));
+
+    // The two paths may contract multiply-adds differently, so they agree to rounding only.
+    auto acc = cp;
+    acc *= cq;
+    EXPECT_TRUE(dcn::is_canonical(acc.value()));
+    EXPECT_TRUE(are_same(res.value(), acc.value(), atol));
+
+    const auto inv = inverse(cp);
+    EXPECT_TRUE(dcn::is_canonical(inv.value()));
+    EXPECT_TRUE(is_identity((cp * inv).value(), atol));
+
+    const auto v = C(TypeParam(3), TypeParam(4));
+    EXPECT_COMPLEX_ALMOST_EQUAL(dcn::transform(p, v), dcn::transform(cp, v), atol);
+
+    EXPECT_EQ(CDC(p), CDC(DC(-p)));
+    EXPECT_NE(CDC(p), CDC(q));
+    EXPECT_TRUE(is_identity(CDC().value(), atol));
+}
+
+TYPED_TEST(DualComplexCanonicalTest, are_same)
+{
+    using C = std::complex<TypeParam>;
+    using CDC = dcn::CanonicalDualComplex<TypeParam>;
+    using Fixture = DualComplexCanonicalTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto t = dcn::translation(C(TypeParam(1), TypeParam(2)));
+    EXPECT_TRUE(are_same(CDC(t * dcn::rotation(TypeParam(1))), CDC(t * dcn::rotation(TypeParam(1))), atol));
+    EXPECT_FALSE(are_same(CDC(t * dcn::rotation(TypeParam(1))), CDC(t * dcn::rotation(TypeParam(1.1))), atol));
+    // Either side of a half turn.
+    const auto eps = atol * TypeParam(0.1);
+    EXPECT_TRUE(are_same(
+        CDC(t * dcn::rotation(Fixture::PI - eps)),
+        CDC(t * dcn::rotation(Fixture::PI + eps)),
+        atol));
+}
+
+}   // namespace
@@ -0,0 +1,146 @@
+#include <atomic>
+#include <thread>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_channel.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexChannelTest
+    : public ::testing::Test
+{
+protected:
+    /**
+     * A value whose components can be checked against each other.
+     */
+    static dcn::DualComplex<T> make_value(std::uint64_t k, std::size_t i)
+    {
+        const auto x = static_cast<T>((k * 4 + i) % 1000000);
+        return dcn::DualComplex<T>(x, x + T(1), x + T(2), x + T(3));
+    }
+
+    static bool is_consistent(const dcn::DualComplex<T>& dc)
+    {
+        const auto x = dc.real().real();
+        return dc.real().imag() == x + T(1) && dc.dual().real() == x + T(2) && dc.dual().imag() == x + T(3);
+    }
+
+    /**
+     * One writer publishing as fast as it can while several readers check every value they see.
+     */
+    template<std::size_t Count, std::size_t Slots>
+    static void contend()
+    {
+        dcn::PoseChannel<T, Count, Slots> channel;
+        const std::uint64_t publications = 200000;
+        std::atomic<bool> done(false);
+        std::atomic<std::size_t> errors(0);
+        std::atomic<std::size_t> reads(0);
+        std::atomic<int> started(0);
+
+        std::vector<std::thread> readers;
+        for(int r = 0; r < 4; r++)
+        {
+            readers.emplace_back([&]()
+            {
+                std::uint64_t last = 0;
+                dcn::DualComplex<T> poses[Count];
+                started++;
+                do
+                {
+                    const auto v = channel.read(poses);
+                    if(v < last)
+                        errors++;
+                    if(v > 0)
+                    {
+                        for(std::size_t i = 0; i < Count; i++)
+                        {
+                            const auto expected = make_value(v, i);
+                            if(!is_consistent(poses[i]) || poses[i].real().real() != expected.real().real())
+                                errors++;
+                        }
+                    }
+                    last = v;
+                    reads++;
+                }
+                while(!done.load(std::memory_order_acquire));
+            });
+        }
+
+        while(started.load() < 4)
+            std::this_thread::yield();
+
+        dcn::DualComplex<T> poses[Count];
+        for(std::uint64_t k = 1; k <= publications; k++)
+        {
+            for(std::size_t i = 0; i < Count; i++)
+                poses[i] = make_value(k, i);
+            channel.publish(poses);
+        }
+        done.store(true, std::memory_order_release);
+        for(auto& reader : readers)
+            reader.join();
+
+        EXPECT_EQ(errors.load(), 0u);
+        EXPECT_GT(reads.load(), 0u);
+        EXPECT_EQ(channel.version(), publications);
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexChannelTest, MyTypes);
+
+TYPED_TEST(DualComplexChannelTest, publish_and_read)
+{
+    using T = TypeParam;
+    using DC = dcn::DualComplex<T>;
+
+    dcn::PoseChannel<T> channel;
+    DC pose;
+    EXPECT_EQ(channel.version(), 0u);
+    EXPECT_EQ(channel.read(pose), 0u);
+
+    const auto p0 = dcn::translation(std::complex<T>(T(1), T(2))) * dcn::rotation(T(0.5));
+    channel.publish(p0);
+    EXPECT_EQ(channel.read(pose), 1u);
+    EXPECT_EQ(pose.real(), p0.real());
+    EXPECT_EQ(pose.dual(), p0.dual());
+
+    // More publications than slots.
+    for(int k = 0; k < 10; k++)
+        channel.publish(dcn::rotation(static_cast<T>(k)));
+    EXPECT_EQ(channel.read(pose), 11u);
+    EXPECT_EQ(pose.real(), dcn::rotation(T(9)).real());
+}
+
+TYPED_TEST(DualComplexChannelTest, array)
+{
+    using T = TypeParam;
+    using DC = dcn::DualComplex<T>;
+
+    dcn::PoseChannel<T, 3> channel;
+    const DC poses[3] = { TestFixture::make_value(1, 0), TestFixture::make_value(1, 1), TestFixture::make_value(1, 2) };
+    channel.publish(poses);
+
+    DC res[3];
+    EXPECT_EQ(channel.read(res), 1u);
+    for(std::size_t i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(res[i].real(), poses[i].real());
+        EXPECT_EQ(res[i].dual(), poses[i].dual());
+    }
+}
+
+TYPED_TEST(DualComplexChannelTest, contention)
+{
+    TestFixture::template contend<1, 4>();
+    TestFixture::template contend<8, 4>();
+    // Readers are lapped far more often.
+    TestFixture::template contend<8, 2>();
+}
+
+}   // namespace
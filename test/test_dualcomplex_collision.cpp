@@ -0,0 +1,169 @@
+#include <random>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_collision.h>
+#include "gtest_helper.h"
+#include "pose_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexCollisionTest
+    : public ::testing::Test
+{
+protected:
+    static const T PI;
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    /**
+     * Checks that the distance does not depend on the argument order or on a common motion.
+     */
+    template<typename S0, typename S1>
+    static void expect_invariant(const S0& s0, const dcn::DualComplex<T>& p0, const S1& s1, const dcn::DualComplex<T>& p1)
+    {
+        const auto d = dcn::signed_distance(s0, p0, s1, p1);
+        EXPECT_NEAR(dcn::signed_distance(s1, p1, s0, p0), d, absolute_tolerance());
+        const auto motion = pose_helper::make_pose(T(3), T(-7), T(2.2));
+        EXPECT_NEAR(dcn::signed_distance(s0, motion * p0, s1, motion * p1), d, T(10) * absolute_tolerance());
+        EXPECT_EQ(dcn::overlap(s0, p0, s1, p1), d <= T(0));
+    }
+};
+
+template<typename T>
+const T
+DualComplexCollisionTest<T>::PI = std::acos(-T(1));
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexCollisionTest, MyTypes);
+
+TYPED_TEST(DualComplexCollisionTest, circle)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    const dcn::Circle<T> a(T(1));
+    const dcn::Circle<T> b(T(0.5));
+    EXPECT_NEAR(dcn::signed_distance(a, pose_helper::make_pose(T(0), T(0), T(1)), b, pose_helper::make_pose(T(3), T(4), T(0))), T(3.5), atol);
+    EXPECT_NEAR(dcn::signed_distance(a, pose_helper::make_pose(T(0), T(0), T(0)), b, pose_helper::make_pose(T(1), T(0), T(0))), T(-0.5), atol);
+    EXPECT_TRUE(dcn::overlap(a, pose_helper::make_pose(T(0), T(0), T(0)), b, pose_helper::make_pose(T(1.5), T(0), T(0))));
+    EXPECT_FALSE(dcn::overlap(a, pose_helper::make_pose(T(0), T(0), T(0)), b, pose_helper::make_pose(T(1.6), T(0), T(0))));
+}
+
+TYPED_TEST(DualComplexCollisionTest, box)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+    const auto half_turn = TestFixture::PI;
+
+    const dcn::Box<T> box(T(1), T(0.5));
+    const auto origin = pose_helper::make_pose(T(0), T(0), T(0));
+
+    // Separated, face to face.
+    EXPECT_NEAR(dcn::signed_distance(box, origin, box, pose_helper::make_pose(T(2.5), T(0.2), T(0))), T(0.5), atol);
+    // Penetrating.
+    EXPECT_NEAR(dcn::signed_distance(box, origin, box, pose_helper::make_pose(T(0.2), T(0.9), T(0))), T(-0.1), atol);
+    // A corner of a box turned by a quarter turn towards a face.
+    EXPECT_NEAR(dcn::signed_distance(box, origin, box, pose_helper::make_pose(T(0), T(2), half_turn / T(2))), T(0.5), atol);
+    // Corner to corner.
+    const auto d = std::sqrt(T(2)) * T(0.5);
+    EXPECT_NEAR(dcn::signed_distance(dcn::Box<T>(T(1), T(1)), origin, dcn::Box<T>(T(0.5), T(0.5)), pose_helper::make_pose(T(1.5) + d, T(0), half_turn / T(4))), T(0.5), atol);
+
+    EXPECT_NEAR(dcn::signed_distance(box, origin, dcn::Circle<T>(T(0.5)), pose_helper::make_pose(T(2), T(1.5), T(0))), std::sqrt(T(2)) - T(0.5), atol);
+    // A point inside a box is as deep as its distance to the nearest face.
+    EXPECT_NEAR(dcn::signed_distance(box, origin, dcn::Circle<T>(T(0.1)), pose_helper::make_pose(T(0.7), T(0.1), T(0))), T(-0.4), atol);
+}
+
+TYPED_TEST(DualComplexCollisionTest, capsule)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+    const auto half_turn = TestFixture::PI;
+
+    const dcn::Capsule<T> capsule(T(2), T(0.5));
+    const auto origin = pose_helper::make_pose(T(0), T(0), T(0));
+
+    EXPECT_NEAR(dcn::signed_distance(capsule, origin, dcn::Circle<T>(T(1)), pose_helper::make_pose(T(1), T(3), T(0))), T(1.5), atol);
+    EXPECT_NEAR(dcn::signed_distance(capsule, origin, dcn::Circle<T>(T(1)), pose_helper::make_pose(T(5), T(0), T(0))), T(1.5), atol);
+    // Crossing capsules must move apart by a half length of the segments, plus both radii.
+    EXPECT_NEAR(dcn::signed_distance(capsule, origin, capsule, pose_helper::make_pose(T(0), T(0), half_turn / T(2))), T(-3), atol);
+    // Collinear, end to end.
+    EXPECT_NEAR(dcn::signed_distance(capsule, origin, capsule, pose_helper::make_pose(T(6), T(0), T(0))), T(1), atol);
+    // Parallel.
+    EXPECT_NEAR(dcn::signed_distance(capsule, origin, capsule, pose_helper::make_pose(T(1), T(3), half_turn)), T(2), atol);
+    // Against a box edge.
+    EXPECT_NEAR(dcn::signed_distance(capsule, pose_helper::make_pose(T(0), T(2), T(0.1)), dcn::Box<T>(T(3), T(1)), origin),
+        T(2) - std::sin(T(0.1)) * T(2) - T(1.5), atol);
+}
+
+TYPED_TEST(DualComplexCollisionTest, invariance)
+{
+    using T = TypeParam;
+
+    std::mt19937 engine(5);
+    std::uniform_real_distribution<T> dist(T(-3), T(3));
+    auto pose = [&](){ const auto x = dist(engine); const auto y = dist(engine); return pose_helper::make_pose(x, y, dist(engine)); };
+
+    const dcn::Box<T> box(T(1), T(0.3));
+    const dcn::Circle<T> circle(T(0.4));
+    const dcn::Capsule<T> capsule(T(0.8), T(0.2));
+    for(int i = 0; i < 100; i++)
+    {
+        TestFixture::expect_invariant(box, pose(), box, pose());
+        TestFixture::expect_invariant(box, pose(), circle, pose());
+        TestFixture::expect_invariant(box, pose(), capsule, pose());
+        TestFixture::expect_invariant(capsule, pose(), capsule, pose());
+        TestFixture::expect_invariant(capsule, pose(), circle, pose());
+    }
+}
+
+TYPED_TEST(DualComplexCollisionTest, broad_phase)
+{
+    using T = TypeParam;
+
+    std::mt19937 engine(9);
+    std::uniform_real_distribution<T> dist(T(0), T(30));
+    std::uniform_real_distribution<T> size(T(0.1), T(1.5));
+
+    std::vector<dcn::Box<T>> shapes;
+    std::vector<dcn::DualComplex<T>> poses;
+    std::vector<dcn::Aabb<T>> boxes;
+    for(int i = 0; i < 300; i++)
+    {
+        const auto w = size(engine);
+        shapes.push_back(dcn::Box<T>(w, size(engine)));
+        const auto x = dist(engine);
+        const auto y = dist(engine);
+        poses.push_back(pose_helper::make_pose(x, y, dist(engine)));
+        boxes.push_back(dcn::aabb(shapes.back(), poses.back()));
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>> expected_boxes;
+    std::vector<std::pair<std::size_t, std::size_t>> expected_shapes;
+    for(std::size_t i = 0; i < boxes.size(); i++)
+    {
+        for(std::size_t j = i + 1; j < boxes.size(); j++)
+        {
+            if(boxes[i].min.real() <= boxes[j].max.real() && boxes[j].min.real() <= boxes[i].max.real()
+            && boxes[i].min.imag() <= boxes[j].max.imag() && boxes[j].min.imag() <= boxes[i].max.imag())
+                expected_boxes.push_back(std::make_pair(i, j));
+            if(dcn::overlap(shapes[i], poses[i], shapes[j], poses[j]))
+                expected_shapes.push_back(std::make_pair(i, j));
+        }
+    }
+
+    EXPECT_EQ(dcn::sweep_and_prune(boxes.data(), boxes.size()), expected_boxes);
+    EXPECT_EQ(dcn::overlapping_pairs(shapes.data(), poses.data(), shapes.size()), expected_shapes);
+    EXPECT_FALSE(expected_shapes.empty());
+    EXPECT_LT(expected_shapes.size(), expected_boxes.size());
+}
+
+}   // namespace
@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <random>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_interpolation.h>
+#include <dualcomplex/dualcomplex_deskew.h>
+#include "gtest_helper.h"
+#include "pose_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexDeskewTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-9; }
+
+    /**
+     * Transforms each point with its own interpolated pose, the way the kernel replaces.
+     */
+    static std::vector<std::complex<T>> naive(
+        const std::vector<T>& track_times,
+        const std::vector<dcn::DualComplex<T>>& track_poses,
+        const dcn::DualComplex<T>& reference,
+        const std::vector<T>& times,
+        const std::vector<std::complex<T>>& points)
+    {
+        std::vector<std::complex<T>> res;
+        for(std::size_t k = 0; k < times.size(); k++)
+        {
+            std::size_t s = 0;
+            while(s + 2 < track_times.size() && !(times[k] < track_times[s + 1]))
+                s++;
+            auto a = (times[k] - track_times[s]) / (track_times[s + 1] - track_times[s]);
+            a = std::min(std::max(a, T(0)), T(1));
+            const auto pose = dcn::slerp_shortestpath(track_poses[s], track_poses[s + 1], a);
+            res.push_back(dcn::transform(dcn::transformation_difference(reference, pose), points[k]));
+        }
+        return res;
+    }
+
+    static void make_scan(std::size_t count, T t0, T t1, std::vector<T>& times, std::vector<std::complex<T>>& points)
+    {
+        std::mt19937 engine(11);
+        std::uniform_real_distribution<T> time_dist(t0, t1);
+        std::uniform_real_distribution<T> point_dist(T(-30), T(30));
+        times.clear();
+        points.clear();
+        for(std::size_t k = 0; k < count; k++)
+        {
+            times.push_back(time_dist(engine));
+            const auto x = point_dist(engine);
+            points.push_back(std::complex<T>(x, point_dist(engine)));
+        }
+    }
+
+    static void expect_near(const std::vector<std::complex<T>>& lhs, const std::vector<std::complex<T>>& rhs)
+    {
+        ASSERT_EQ(lhs.size(), rhs.size());
+        for(std::size_t k = 0; k < lhs.size(); k++)
+            EXPECT_COMPLEX_ALMOST_EQUAL(lhs[k], rhs[k], absolute_tolerance());
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexDeskewTest, MyTypes);
+
+TYPED_TEST(DualComplexDeskewTest, two_poses)
+{
+    using T = TypeParam;
+
+    // Nearly a half turn, so that the whole table is used.
+    const auto start = pose_helper::make_pose(T(1), T(2), T(0.2));
+    const auto end = pose_helper::make_pose(T(3), T(1), T(3.3));
+
+    std::vector<T> times;
+    std::vector<std::complex<T>> points;
+    TestFixture::make_scan(3000, T(0), T(0.1), times, points);
+    std::sort(times.begin(), times.begin() + 2000);
+
+    for(const auto& reference : { start, end })
+    {
+        std::vector<std::complex<T>> res(points.size());
+        dcn::deskew(start, T(0), end, T(0.1), reference, times.data(), points.data(), points.size(), res.data());
+        TestFixture::expect_near(res,
+            TestFixture::naive({ T(0), T(0.1) }, { start, end }, reference, times, points));
+    }
+}
+
+TYPED_TEST(DualComplexDeskewTest, track)
+{
+    using T = TypeParam;
+
+    const std::vector<T> track_times = { T(-0.01), T(0.02), T(0.05), T(0.11) };
+    const std::vector<dcn::DualComplex<T>> track_poses = {
+        pose_helper::make_pose(T(0), T(0), T(0)),
+        pose_helper::make_pose(T(0.5), T(0.1), T(-0.4)),
+        pose_helper::make_pose(T(1), T(0.3), T(-2.5)),
+        pose_helper::make_pose(T(1.2), T(0.2), T(2.9)),
+    };
+    const auto reference = pose_helper::make_pose(T(0.7), T(0.2), T(-1));
+
+    // Includes times before and after the track, which are clamped.
+    std::vector<T> times;
+    std::vector<std::complex<T>> points;
+    TestFixture::make_scan(2000, T(-0.02), T(0.12), times, points);
+    const auto expected = TestFixture::naive(track_times, track_poses, reference, times, points);
+
+    std::vector<std::complex<T>> res(points.size());
+    dcn::deskew(track_times.data(), track_poses.data(), track_poses.size(), reference,
+        times.data(), points.data(), points.size(), res.data());
+    TestFixture::expect_near(res, expected);
+
+    // Sorted, in place.
+    std::vector<std::size_t> order(times.size());
+    for(std::size_t k = 0; k < order.size(); k++)
+        order[k] = k;
+    std::sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j){ return times[i] < times[j]; });
+    std::vector<T> sorted_times;
+    std::vector<std::complex<T>> sorted_points;
+    std::vector<std::complex<T>> sorted_expected;
+    for(auto k : order)
+    {
+        sorted_times.push_back(times[k]);
+        sorted_points.push_back(points[k]);
+        sorted_expected.push_back(expected[k]);
+    }
+    dcn::deskew(track_times.data(), track_poses.data(), track_poses.size(), reference,
+        sorted_times.data(), sorted_points.data(), sorted_points.size(), sorted_points.data());
+    TestFixture::expect_near(sorted_points, sorted_expected);
+}
+
+}   // namespace
@@ -0,0 +1,148 @@
+#include <random>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_query.h>
+#include <dualcomplex/dualcomplex_estimation.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexEstimationTest
+    : public ::testing::Test
+{
+protected:
+    static const T PI;
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-3f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    static std::vector<std::complex<T>> random_points(std::size_t count, unsigned seed, const std::complex<T>& center)
+    {
+        std::mt19937 engine(seed);
+        std::uniform_real_distribution<T> dist(T(-10), T(10));
+
+        std::vector<std::complex<T>> res;
+        for(std::size_t i = 0; i < count; i++)
+        {
+            const auto x = dist(engine);
+            res.push_back(center + std::complex<T>(x, dist(engine)));
+        }
+        return res;
+    }
+};
+
+template<typename T>
+const T
+DualComplexEstimationTest<T>::PI = std::acos(-T(1));
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexEstimationTest, MyTypes);
+
+TYPED_TEST(DualComplexEstimationTest, estimate)
+{
+    using C = std::complex<TypeParam>;
+    using Fixture = DualComplexEstimationTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto truth = dcn::translation(C(TypeParam(1), TypeParam(-2))) * dcn::rotation(Fixture::PI / TypeParam(3));
+    const auto src = Fixture::random_points(30, 1, C(TypeParam(0), TypeParam(0)));
+    std::vector<C> dst(src.size());
+    dcn::transform(truth, src.data(), src.size(), dst.data());
+
+    dcn::PoseFitAccumulator<TypeParam> acc;
+    acc.add(src.data(), dst.data(), src.size());
+
+    EXPECT_ALMOST_EQUAL(TypeParam(src.size()), acc.weight(), atol);
+    EXPECT_TRUE(are_same(truth, acc.estimate(), atol));
+}
+
+TYPED_TEST(DualComplexEstimationTest, weighted_procrustes)
+{
+    using C = std::complex<TypeParam>;
+    using Fixture = DualComplexEstimationTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto truth = dcn::translation(C(TypeParam(1), TypeParam(-2))) * dcn::rotation(-Fixture::PI / TypeParam(5));
+    const auto src = Fixture::random_points(30, 2, C(TypeParam(0), TypeParam(0)));
+    std::vector<C> dst(src.size());
+    dcn::transform(truth, src.data(), src.size(), dst.data());
+    std::vector<TypeParam> weights(src.size());
+    for(std::size_t i = 0; i < weights.size(); i++)
+        weights[i] = TypeParam(1) + TypeParam(i % 4);
+    // An outlier with zero weight does not change the result.
+    dst[0] += C(TypeParam(100), TypeParam(100));
+    weights[0] = TypeParam(0);
+
+    const auto res = dcn::weighted_procrustes(src.data(), dst.data(), weights.data(), src.size());
+
+    EXPECT_TRUE(are_same(truth, res, atol));
+}
+
+TYPED_TEST(DualComplexEstimationTest, merge)
+{
+    using C = std::complex<TypeParam>;
+    using Acc = dcn::PoseFitAccumulator<TypeParam>;
+    using Fixture = DualComplexEstimationTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto truth = dcn::translation(C(TypeParam(3), TypeParam(4))) * dcn::rotation(Fixture::PI / TypeParam(7));
+    const auto src = Fixture::random_points(40, 3, C(TypeParam(0), TypeParam(0)));
+    std::vector<C> dst(src.size());
+    dcn::transform(truth, src.data(), src.size(), dst.data());
+    // Perturb so that the fit is not exact.
+    for(std::size_t i = 0; i < dst.size(); i++)
+        dst[i] += C(TypeParam(0.01) * TypeParam(i % 3), TypeParam(-0.01) * TypeParam(i % 5));
+
+    Acc whole;
+    whole.add(src.data(), dst.data(), src.size());
+
+    Acc parts[3];
+    parts[0].add(src.data(), dst.data(), 10);
+    parts[1].add(src.data() + 10, dst.data() + 10, 25);
+    parts[2].add(src.data() + 35, dst.data() + 35, 5);
+    const auto merged = (parts[0] + parts[1]) + (Acc() + parts[2]);
+
+    EXPECT_ALMOST_EQUAL(whole.weight(), merged.weight(), atol);
+    EXPECT_COMPLEX_ALMOST_EQUAL(whole.src_centroid(), merged.src_centroid(), atol);
+    EXPECT_COMPLEX_ALMOST_EQUAL(whole.dst_centroid(), merged.dst_centroid(), atol);
+    EXPECT_COMPLEX_ALMOST_EQUAL(whole.covariance(), merged.covariance(), TypeParam(10) * atol);
+    EXPECT_TRUE(are_same(whole.estimate(), merged.estimate(), atol));
+}
+
+TYPED_TEST(DualComplexEstimationTest, far_from_origin)
+{
+    using C = std::complex<TypeParam>;
+    using Fixture = DualComplexEstimationTest<TypeParam>;
+
+    const auto center = C(TypeParam(1000), TypeParam(-1000));
+    const auto angle = Fixture::PI / TypeParam(6);
+    const auto truth = dcn::translation(C(TypeParam(1), TypeParam(1))) * dcn::rotation(angle);
+    const auto src = Fixture::random_points(100, 4, center);
+    std::vector<C> dst(src.size());
+    dcn::transform(truth, src.data(), src.size(), dst.data());
+
+    dcn::PoseFitAccumulator<TypeParam> acc;
+    acc.add(src.data(), dst.data(), src.size());
+    const auto res = acc.estimate();
+
+    // The recovered transformation maps the source onto the destination.
+    const auto rtol = TypeParam(100) * Fixture::absolute_tolerance();
+    for(std::size_t i = 0; i < src.size(); i++)
+    {
+        EXPECT_LT(std::abs(dcn::transform(res, src[i]) - dst[i]), rtol);
+    }
+    EXPECT_NEAR(angle, TypeParam(2) * std::arg(res.real()), rtol);
+}
+
+}   // namespace
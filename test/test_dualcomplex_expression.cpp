@@ -0,0 +1,121 @@
+#include <random>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_interpolation.h>
+#include <dualcomplex/dualcomplex_expression.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexExpressionTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    static std::vector<dcn::DualComplex<T>> make_poses(std::size_t count, std::uint32_t seed)
+    {
+        std::mt19937 engine(seed);
+        std::uniform_real_distribution<T> dist(T(-3), T(3));
+
+        std::vector<dcn::DualComplex<T>> poses;
+        for(std::size_t i = 0; i < count; i++)
+        {
+            const auto x = dist(engine);
+            const auto y = dist(engine);
+            poses.push_back(dcn::translation(std::complex<T>(x, y)) * dcn::rotation(dist(engine)));
+        }
+        return poses;
+    }
+};
+
+#define EXPECT_DUALCOMPLEX_ALMOST_EQUAL(lhs, rhs, tolerance) \
+    do { \
+        EXPECT_COMPLEX_ALMOST_EQUAL((lhs).real(), (rhs).real(), tolerance); \
+        EXPECT_COMPLEX_ALMOST_EQUAL((lhs).dual(), (rhs).dual(), tolerance); \
+    } while(false)
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexExpressionTest, MyTypes);
+
+TYPED_TEST(DualComplexExpressionTest, lerp)
+{
+    using SoA = dcn::DualComplexSoA<TypeParam>;
+    using Fixture = DualComplexExpressionTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto a = Fixture::make_poses(100, 1);
+    const auto b = Fixture::make_poses(100, 2);
+    const SoA sa(a);
+    const SoA sb(b);
+    const auto t = TypeParam(0.3);
+
+    const SoA res = (TypeParam(1) - t) * dcn::lazy(sa) + dcn::lazy(sb) * t;
+    ASSERT_EQ(a.size(), res.size());
+    for(std::size_t i = 0; i < a.size(); i++)
+    {
+        EXPECT_DUALCOMPLEX_ALMOST_EQUAL(dcn::lerp(a[i], b[i], t), res[i], atol);
+    }
+}
+
+TYPED_TEST(DualComplexExpressionTest, arithmetic)
+{
+    using SoA = dcn::DualComplexSoA<TypeParam>;
+    using Fixture = DualComplexExpressionTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto a = Fixture::make_poses(50, 3);
+    const auto b = Fixture::make_poses(50, 4);
+    const auto c = Fixture::make_poses(1, 5).front();
+    const SoA sa(a);
+    const SoA sb(b);
+
+    SoA res;
+    res = c * (dcn::lazy(sa) * dcn::lazy(sb)) - (-dcn::lazy(sb)) * c;
+    ASSERT_EQ(a.size(), res.size());
+    for(std::size_t i = 0; i < a.size(); i++)
+    {
+        EXPECT_DUALCOMPLEX_ALMOST_EQUAL(c * (a[i] * b[i]) + b[i] * c, res[i], atol);
+    }
+
+    // In place.
+    res = dcn::lazy(res) * dcn::lazy(sa);
+    for(std::size_t i = 0; i < a.size(); i++)
+    {
+        EXPECT_DUALCOMPLEX_ALMOST_EQUAL((c * (a[i] * b[i]) + b[i] * c) * a[i], res[i], atol);
+    }
+}
+
+TYPED_TEST(DualComplexExpressionTest, dlb)
+{
+    using SoA = dcn::DualComplexSoA<TypeParam>;
+    using Fixture = DualComplexExpressionTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto transforms = Fixture::make_poses(20, 6);
+    std::vector<TypeParam> weights;
+    for(std::size_t i = 0; i < transforms.size(); i++)
+        weights.push_back(TypeParam(i + 1) / TypeParam(210));
+    const SoA soa(transforms);
+
+    const auto blended = dcn::sum(dcn::lazy(weights) * dcn::lazy(soa));
+    const auto res = blended / dcn::norm(blended);
+    EXPECT_DUALCOMPLEX_ALMOST_EQUAL(dcn::dlb(transforms, weights), res, atol);
+
+    const auto other = dcn::sum(dcn::lazy(soa) * dcn::lazy(weights));
+    EXPECT_DUALCOMPLEX_ALMOST_EQUAL(blended, other, atol);
+}
+
+}   // namespace
@@ -0,0 +1,218 @@
+#include <cstdint>
+#include <limits>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_common.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_interpolation.h>
+#include <dualcomplex/dualcomplex_fixed_point.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexFixedPointTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, dcn::Q16_16>::value, double>::type
+    absolute_tolerance(){ return 1e-4; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, dcn::Q32_32>::value, double>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    static double to_double(const T& x)
+    {
+        return static_cast<double>(x);
+    }
+
+    /**
+     * Runs a short simulation and returns an FNV-1a hash of every intermediate raw value.
+     */
+    static std::uint64_t simulate()
+    {
+        using C = std::complex<T>;
+
+        std::uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](const T& x)
+        {
+            auto u = static_cast<std::uint64_t>(static_cast<std::int64_t>(x.raw()));
+            for(int i = 0; i < 8; i++)
+            {
+                hash ^= u & 0xffu;
+                hash *= 1099511628211ull;
+                u >>= 8;
+            }
+        };
+
+        const auto step = dcn::translation(C(T(0.125), T(-0.0625))) * dcn::rotation(T(0.03125));
+        auto pose = dcn::DualComplex<T>(T(1), T(0), T(0), T(0));
+        auto target = dcn::rotation(T(-2.5));
+        for(int i = 0; i < 500; i++)
+        {
+            pose = pose * step;
+            if(i % 10 == 0)
+                pose = dcn::nlerp(pose, target, T(0.25));
+
+            const auto p = dcn::transform(pose, C(T(1), T(2)));
+            mix(pose.real().real());
+            mix(pose.real().imag());
+            mix(pose.dual().real());
+            mix(pose.dual().imag());
+            mix(p.real());
+            mix(p.imag());
+            target = dcn::rotation(T(i) / T(100));
+        }
+        return hash;
+    }
+};
+
+using MyTypes = ::testing::Types<dcn::Q16_16, dcn::Q32_32>;
+TYPED_TEST_SUITE(DualComplexFixedPointTest, MyTypes);
+
+TYPED_TEST(DualComplexFixedPointTest, arithmetic)
+{
+    using T = TypeParam;
+    using Fixture = DualComplexFixedPointTest<T>;
+
+    EXPECT_EQ(T(3), T(1.5) * T(2));
+    EXPECT_EQ(T(0.75), T(3) / T(4));
+    EXPECT_EQ(T(-0.75), T(-3) / T(4));
+    EXPECT_EQ(T(-1.25), T(0.25) - T(1.5));
+    EXPECT_EQ(T(2.5), dcn::abs(T(-2.5)));
+    EXPECT_TRUE(T(-1) < T(0.5));
+    EXPECT_EQ(-2.75, Fixture::to_double(T(-2.75)));
+
+    const auto scale = std::ldexp(1.0, -T::fraction_bits);
+    EXPECT_NEAR(std::sqrt(2.0), Fixture::to_double(dcn::sqrt(T(2))), scale);
+    EXPECT_NEAR(std::sqrt(1000.5), Fixture::to_double(dcn::sqrt(T(1000.5))), scale);
+    EXPECT_EQ(T(3), dcn::sqrt(T(9)));
+    EXPECT_NEAR(-0.1234 * 5.678, Fixture::to_double(T(-0.1234) * T(5.678)), 8.0 * scale);
+}
+
+TYPED_TEST(DualComplexFixedPointTest, saturation)
+{
+    using T = TypeParam;
+    using Rep = typename T::rep_type;
+
+    const auto max = T::from_raw(std::numeric_limits<Rep>::max());
+    const auto min = T::from_raw(std::numeric_limits<Rep>::min());
+    const auto upper = std::numeric_limits<Rep>::max() >> T::fraction_bits;
+
+    // Integers at the ends of the range and beyond.
+    EXPECT_EQ(T(upper).raw(), upper << T::fraction_bits);
+    EXPECT_EQ(T(-upper - 1), min);
+    EXPECT_EQ(T(upper + 1), max);
+    EXPECT_EQ(T(-upper - 2), min);
+    EXPECT_EQ(T(std::numeric_limits<std::int64_t>::max()), max);
+    EXPECT_EQ(T(std::numeric_limits<std::int64_t>::min()), min);
+    EXPECT_EQ(T(std::numeric_limits<std::uint64_t>::max()), max);
+
+    // Division by zero saturates toward the sign of the dividend.
+    EXPECT_EQ(T(2) / T(0), max);
+    EXPECT_EQ(T(-2) / T(0), min);
+    EXPECT_EQ(T(0) / T(0), T(0));
+
+    // Sums, differences, negation and quotients out of range saturate toward the sign of the exact result.
+    const auto ulp = T::from_raw(1);
+    EXPECT_EQ(max + ulp, max);
+    EXPECT_EQ(max + max, max);
+    EXPECT_EQ(min + min, min);
+    EXPECT_EQ(min - ulp, min);
+    EXPECT_EQ(max - min, max);
+    EXPECT_EQ(min - max, min);
+    EXPECT_EQ(max + min, -ulp);
+    EXPECT_EQ(-min, max);
+    EXPECT_EQ(-max, min + ulp);
+    EXPECT_EQ(max / ulp, max);
+    EXPECT_EQ(max / -ulp, min);
+    EXPECT_EQ(min / ulp, min);
+    EXPECT_EQ(min / -ulp, max);
+    EXPECT_EQ(T(-upper - 1) / T(1), min);
+    EXPECT_EQ(T(upper) / T(0.5), max);
+
+    // Floating point numbers out of range saturate, and NaN becomes zero.
+    EXPECT_EQ(T(1e30), max);
+    EXPECT_EQ(T(-1e30), min);
+    EXPECT_EQ(T(std::numeric_limits<double>::infinity()), max);
+    EXPECT_EQ(T(-std::numeric_limits<double>::infinity()), min);
+    EXPECT_EQ(T(std::numeric_limits<double>::quiet_NaN()), T(0));
+    EXPECT_EQ(T(-static_cast<double>(upper) - 1.0), min);
+}
+
+TEST(DualComplexFixedPointQ16_16Test, float_saturation)
+{
+    EXPECT_EQ(dcn::Q16_16(1e6).raw(), std::numeric_limits<std::int32_t>::max());
+    EXPECT_EQ(dcn::Q16_16(-1e6).raw(), std::numeric_limits<std::int32_t>::min());
+    EXPECT_EQ(dcn::Q16_16(32767.5).raw(), std::int32_t(32767.5 * 65536.0));
+}
+
+TYPED_TEST(DualComplexFixedPointTest, sincos)
+{
+    using T = TypeParam;
+    using Fixture = DualComplexFixedPointTest<T>;
+
+    const auto scale = std::ldexp(1.0, -T::fraction_bits);
+    for(int i = -2000; i <= 2000; i++)
+    {
+        const auto x = T(static_cast<double>(i) * 0.0173);
+        const auto xd = Fixture::to_double(x);
+        EXPECT_NEAR(std::sin(xd), Fixture::to_double(dcn::sin(x)), std::max(scale, 1e-12));
+        EXPECT_NEAR(std::cos(xd), Fixture::to_double(dcn::cos(x)), std::max(scale, 1e-12));
+    }
+    {
+        const auto x = T(1000.3);
+        const auto xd = Fixture::to_double(x);
+        EXPECT_NEAR(std::sin(xd), Fixture::to_double(dcn::sin(x)), std::max(scale, 1e-12));
+    }
+}
+
+TYPED_TEST(DualComplexFixedPointTest, dual_complex)
+{
+    using T = TypeParam;
+    using C = std::complex<T>;
+    using Fixture = DualComplexFixedPointTest<T>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto p = dcn::translation(C(T(1), T(-2))) * dcn::rotation(T(0.75));
+    const auto q = dcn::translation(C(T(-0.5), T(3))) * dcn::rotation(T(-1.25));
+    const auto pd = dcn::translation(std::complex<double>(1.0, -2.0)) * dcn::rotation(0.75);
+    const auto qd = dcn::translation(std::complex<double>(-0.5, 3.0)) * dcn::rotation(-1.25);
+
+    const auto expect_near = [atol](const dcn::DualComplex<double>& expected, const dcn::DualComplex<T>& res)
+    {
+        const auto converted = dcn::DualComplex<double>(res);
+        EXPECT_NEAR(expected.real().real(), converted.real().real(), atol);
+        EXPECT_NEAR(expected.real().imag(), converted.real().imag(), atol);
+        EXPECT_NEAR(expected.dual().real(), converted.dual().real(), atol);
+        EXPECT_NEAR(expected.dual().imag(), converted.dual().imag(), atol);
+    };
+
+    expect_near(pd * qd, p * q);
+    expect_near(dcn::nlerp(pd, qd, 0.3), dcn::nlerp(p, q, T(0.3)));
+    expect_near(dcn::normalize(pd * qd), dcn::normalize(p * q));
+
+    const auto v = dcn::transform(p, C(T(2), T(1)));
+    const auto vd = dcn::transform(pd, std::complex<double>(2.0, 1.0));
+    EXPECT_NEAR(vd.real(), Fixture::to_double(v.real()), atol);
+    EXPECT_NEAR(vd.imag(), Fixture::to_double(v.imag()), atol);
+}
+
+TYPED_TEST(DualComplexFixedPointTest, determinism)
+{
+    using T = TypeParam;
+    using Fixture = DualComplexFixedPointTest<T>;
+
+    const auto hash = Fixture::simulate();
+    EXPECT_EQ(hash, Fixture::simulate());
+
+    // Bit-exact results recorded once; any platform must reproduce them.
+    const auto expected = std::is_same<T, dcn::Q16_16>::value ? 15320735269043760381ull : 12968538488495751602ull;
+    EXPECT_EQ(expected, hash);
+}
+
+}   // namespace
@@ -0,0 +1,161 @@
+#include <map>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_hash.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexHashTest
+    : public ::testing::Test
+{
+protected:
+    static const T PI;
+
+    static std::vector<dcn::DualComplex<T>> make_poses(std::size_t count, std::uint32_t seed)
+    {
+        std::mt19937 engine(seed);
+        std::uniform_real_distribution<T> position(T(-5), T(5));
+        std::uniform_real_distribution<T> angle(-PI, PI);
+
+        std::vector<dcn::DualComplex<T>> poses;
+        for(std::size_t i = 0; i < count; i++)
+        {
+            const auto x = position(engine);
+            const auto y = position(engine);
+            poses.push_back(dcn::translation(std::complex<T>(x, y)) * dcn::rotation(angle(engine)));
+        }
+        return poses;
+    }
+};
+
+template<typename T>
+const T
+DualComplexHashTest<T>::PI = std::acos(-T(1));
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexHashTest, MyTypes);
+
+TYPED_TEST(DualComplexHashTest, hash)
+{
+    using DC = dcn::DualComplex<TypeParam>;
+    using CDC = dcn::CanonicalDualComplex<TypeParam>;
+    using Fixture = DualComplexHashTest<TypeParam>;
+
+    const std::hash<DC> hasher;
+    const auto poses = Fixture::make_poses(100, 1);
+    for(const auto& p : poses)
+    {
+        EXPECT_EQ(hasher(p), hasher(DC(-p)));
+        EXPECT_EQ(hasher(p), std::hash<CDC>()(CDC(p)));
+    }
+    // Signed zeros.
+    EXPECT_EQ(hasher(DC(TypeParam(1), TypeParam(0), TypeParam(0), TypeParam(0))),
+              hasher(DC(TypeParam(1), -TypeParam(0), -TypeParam(0), TypeParam(0))));
+
+    std::unordered_set<CDC> set;
+    for(const auto& p : poses)
+    {
+        set.insert(CDC(p));
+        set.insert(CDC(DC(-p)));
+    }
+    EXPECT_EQ(poses.size(), set.size());
+
+    std::unordered_map<DC, std::size_t, std::hash<DC>, dcn::CanonicalEqual<TypeParam>> map;
+    for(std::size_t i = 0; i < poses.size(); i++)
+        map[poses[i]] = i;
+    EXPECT_EQ(poses.size(), map.size());
+    for(std::size_t i = 0; i < poses.size(); i++)
+    {
+        const auto it = map.find(DC(-poses[i]));
+        ASSERT_NE(it, map.end());
+        EXPECT_EQ(i, it->second);
+    }
+    EXPECT_TRUE(dcn::CanonicalEqual<TypeParam>()(
+        DC(TypeParam(1), TypeParam(0), TypeParam(0), TypeParam(0)),
+        DC(TypeParam(1), -TypeParam(0), -TypeParam(0), TypeParam(0))));
+    EXPECT_FALSE(dcn::CanonicalEqual<TypeParam>()(poses[0], poses[1]));
+}
+
+TYPED_TEST(DualComplexHashTest, quantized)
+{
+    using DC = dcn::DualComplex<TypeParam>;
+    using Hash = dcn::QuantizedHash<TypeParam>;
+    using Equal = dcn::QuantizedEqual<TypeParam>;
+
+    const auto cell = TypeParam(0.01);
+    const Hash hasher(cell);
+    const Equal equal(cell);
+
+    // Values placed in the middle of a cell, with perturbations well inside it.
+    const auto p = DC(TypeParam(0.605), TypeParam(0.795), TypeParam(1.235), TypeParam(-2.345));
+    for(int i = -4; i <= 4; i++)
+    {
+        const auto e = cell * TypeParam(0.1) * TypeParam(i);
+        const auto q = DC(p.real().real() + e, p.real().imag() - e, p.dual().real() + e, p.dual().imag() + e);
+
+        EXPECT_EQ(hasher(p), hasher(q));
+        EXPECT_EQ(hasher(p), hasher(DC(-q)));
+        EXPECT_TRUE(equal(p, q));
+        EXPECT_TRUE(equal(p, DC(-q)));
+    }
+    {
+        const auto q = DC(p.real().real() + cell, p.real().imag(), p.dual().real(), p.dual().imag());
+        EXPECT_FALSE(equal(p, q));
+    }
+
+    std::unordered_map<DC, int, Hash, Equal> cache(16, hasher, equal);
+    cache[p] = 1;
+    cache[DC(-p)] += 1;
+    ASSERT_EQ(std::size_t(1), cache.size());
+    EXPECT_EQ(2, cache.begin()->second);
+}
+
+TYPED_TEST(DualComplexHashTest, ordering)
+{
+    using DC = dcn::DualComplex<TypeParam>;
+    using CDC = dcn::CanonicalDualComplex<TypeParam>;
+    using Fixture = DualComplexHashTest<TypeParam>;
+
+    const auto poses = Fixture::make_poses(100, 2);
+    for(const auto& p : poses)
+    {
+        EXPECT_FALSE(dcn::canonical_less(p, p));
+        EXPECT_FALSE(dcn::canonical_less(p, DC(-p)));
+        EXPECT_FALSE(dcn::canonical_less(DC(-p), p));
+    }
+    for(std::size_t i = 0; i + 2 < poses.size(); i++)
+    {
+        const auto& a = poses[i];
+        const auto& b = poses[i + 1];
+        const auto& c = poses[i + 2];
+        // Asymmetry and transitivity.
+        EXPECT_FALSE(dcn::canonical_less(a, b) && dcn::canonical_less(b, a));
+        if(dcn::canonical_less(a, b) && dcn::canonical_less(b, c))
+        {
+            EXPECT_TRUE(dcn::canonical_less(a, c));
+        }
+        EXPECT_EQ(dcn::canonical_less(a, b), CDC(a) < CDC(b));
+    }
+
+    std::map<DC, int, dcn::CanonicalLess<TypeParam>> map;
+    std::set<CDC> set;
+    for(const auto& p : poses)
+    {
+        map[p] = 0;
+        map[DC(-p)] = 0;
+        set.insert(CDC(p));
+        set.insert(CDC(DC(-p)));
+    }
+    EXPECT_EQ(poses.size(), map.size());
+    EXPECT_EQ(poses.size(), set.size());
+}
+
+}   // namespace
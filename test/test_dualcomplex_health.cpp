@@ -0,0 +1,139 @@
+#include <limits>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_health.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexHealthTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    /**
+     * Unit transformations, spanning several blocks.
+     */
+    static std::vector<dcn::DualComplex<T>> make_values(std::size_t count)
+    {
+        using C = std::complex<T>;
+        std::vector<dcn::DualComplex<T>> dcs;
+        for(std::size_t i = 0; i < count; i++)
+        {
+            const auto x = static_cast<T>(i % 17) * T(0.37);
+            dcs.push_back(dcn::translation(C(x, -x)) * dcn::rotation(x));
+        }
+        return dcs;
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexHealthTest, MyTypes);
+
+TYPED_TEST(DualComplexHealthTest, healthy)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    const auto dcs = TestFixture::make_values(1000);
+    const auto report = dcn::check_health(dcs.data(), dcs.size(), atol);
+    EXPECT_LE(report.max_norm_deviation, atol);
+    EXPECT_EQ(report.drifted, 0u);
+    EXPECT_EQ(report.non_finite, 0u);
+    EXPECT_TRUE(report.non_finite_indices.empty());
+
+    const auto empty = dcn::check_health(dcs.data(), 0, atol);
+    EXPECT_EQ(empty.max_norm_deviation, T(0));
+    EXPECT_EQ(empty.drifted, 0u);
+    EXPECT_EQ(empty.non_finite, 0u);
+}
+
+TYPED_TEST(DualComplexHealthTest, drift)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    auto dcs = TestFixture::make_values(1000);
+    dcs[3] *= T(1.01);
+    dcs[700] *= T(0.9);
+    dcs[999] *= T(1.05);
+
+    const auto report = dcn::check_health(dcs.data(), dcs.size(), atol);
+    EXPECT_NEAR(report.max_norm_deviation, T(0.1), atol);
+    EXPECT_EQ(report.max_norm_deviation_index, 700u);
+    EXPECT_EQ(report.drifted, 3u);
+    EXPECT_EQ(report.non_finite, 0u);
+
+    EXPECT_EQ(dcn::renormalize_drifted(dcs.data(), dcs.size(), atol), 3u);
+    const auto repaired = dcn::check_health(dcs.data(), dcs.size(), atol);
+    EXPECT_LE(repaired.max_norm_deviation, atol);
+    EXPECT_EQ(repaired.drifted, 0u);
+}
+
+TYPED_TEST(DualComplexHealthTest, non_finite)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+    const auto nan = std::numeric_limits<T>::quiet_NaN();
+    const auto inf = std::numeric_limits<T>::infinity();
+
+    auto dcs = TestFixture::make_values(1000);
+    dcs[10].real() = std::complex<T>(nan, T(0));
+    dcs[300].dual() = std::complex<T>(T(0), -inf);
+    dcs[301].dual() = std::complex<T>(nan, T(0));
+    dcs[900] *= T(1.5);
+
+    const auto report = dcn::check_health(dcs.data(), dcs.size(), atol);
+    EXPECT_EQ(report.non_finite, 3u);
+    ASSERT_EQ(report.non_finite_indices.size(), 3u);
+    EXPECT_EQ(report.non_finite_indices[0], 10u);
+    EXPECT_EQ(report.non_finite_indices[1], 300u);
+    EXPECT_EQ(report.non_finite_indices[2], 301u);
+    // Non-finite elements do not take part in the deviation.
+    EXPECT_NEAR(report.max_norm_deviation, T(0.5), atol);
+    EXPECT_EQ(report.max_norm_deviation_index, 900u);
+    EXPECT_EQ(report.drifted, 1u);
+
+    const auto capped = dcn::check_health(dcs.data(), dcs.size(), atol, 2);
+    EXPECT_EQ(capped.non_finite, 3u);
+    ASSERT_EQ(capped.non_finite_indices.size(), 2u);
+    EXPECT_EQ(capped.non_finite_indices[1], 300u);
+
+    // Non-finite elements are left for the caller to handle, also when only the dual part is non-finite.
+    dcs[500].real() *= T(2);
+    dcs[500].dual() = std::complex<T>(inf, T(0));
+    EXPECT_EQ(dcn::renormalize_drifted(dcs.data(), dcs.size(), atol), 1u);
+    EXPECT_TRUE(std::isnan(dcs[10].real().real()));
+    EXPECT_NEAR(std::abs(dcs[500].real()), T(2), atol);
+}
+
+TYPED_TEST(DualComplexHealthTest, soa)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    auto dcs = TestFixture::make_values(600);
+    dcs[5] *= T(1.2);
+    dcs[599].dual() = std::complex<T>(std::numeric_limits<T>::infinity(), T(0));
+    const dcn::DualComplexSoA<T> soa(dcs);
+
+    const auto expected = dcn::check_health(dcs.data(), dcs.size(), atol);
+    const auto report = dcn::check_health(soa, atol);
+    EXPECT_EQ(report.max_norm_deviation, expected.max_norm_deviation);
+    EXPECT_EQ(report.max_norm_deviation_index, 5u);
+    EXPECT_EQ(report.drifted, expected.drifted);
+    EXPECT_EQ(report.non_finite, 1u);
+    EXPECT_EQ(report.non_finite_indices, expected.non_finite_indices);
+}
+
+}   // namespace
@@ -0,0 +1,199 @@
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_jacobian.h>
+#include <dualcomplex/dualcomplex_hermite.h>
+#include "gtest_helper.h"
+#include "pose_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexHermiteTest
+    : public ::testing::Test
+{
+protected:
+    using vector_type = Eigen::Matrix<T, 3, 1>;
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-9; }
+
+    /**
+     * Keyframes of a random walk with random twists.
+     */
+    static void make_keys(std::size_t count, std::vector<T>& times, std::vector<dcn::DualComplex<T>>& poses, std::vector<vector_type>& twists)
+    {
+        std::mt19937 engine(5);
+        std::uniform_real_distribution<T> dist(T(-1), T(1));
+        times.clear();
+        poses.clear();
+        twists.clear();
+        auto time = T(0);
+        auto pose = pose_helper::make_pose(T(0), T(0), T(0));
+        for(std::size_t i = 0; i < count; i++)
+        {
+            times.push_back(time);
+            poses.push_back(pose);
+            twists.push_back(vector_type(dist(engine), dist(engine), dist(engine)));
+            time += T(0.5) + T(0.25) * dist(engine);
+            pose = pose * pose_helper::make_pose(dist(engine), dist(engine), dist(engine));
+        }
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexHermiteTest, MyTypes);
+
+TYPED_TEST(DualComplexHermiteTest, interpolates_keys)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    std::vector<T> times;
+    std::vector<dcn::DualComplex<T>> poses;
+    std::vector<typename TestFixture::vector_type> twists;
+    TestFixture::make_keys(10, times, poses, twists);
+
+    const dcn::HermiteSpline<T> spline(times.data(), poses.data(), twists.data(), times.size());
+    EXPECT_EQ(spline.size(), times.size());
+    EXPECT_EQ(spline.start_time(), times.front());
+    EXPECT_EQ(spline.end_time(), times.back());
+    for(std::size_t i = 0; i < times.size(); i++)
+        pose_helper::expect_same_motion(spline.evaluate(times[i]), poses[i], T(10) * atol);
+
+    // Times outside the range are clamped.
+    pose_helper::expect_same_motion(spline.evaluate(times.front() - T(1)), poses.front(), T(10) * atol);
+    pose_helper::expect_same_motion(spline.evaluate(times.back() + T(1)), poses.back(), T(10) * atol);
+}
+
+TYPED_TEST(DualComplexHermiteTest, matches_twists)
+{
+    using T = TypeParam;
+
+    std::vector<T> times;
+    std::vector<dcn::DualComplex<T>> poses;
+    std::vector<typename TestFixture::vector_type> twists;
+    TestFixture::make_keys(6, times, poses, twists);
+
+    const dcn::HermiteSpline<T> spline(times.data(), poses.data(), twists.data(), times.size());
+    const auto h = T(1e-3);
+    const auto tol = std::is_same<T, float>::value ? T(5e-2) : T(1e-2);
+    for(std::size_t i = 1; i + 1 < times.size(); i++)
+    {
+        // One-sided differences, so that both segments meeting at a key are checked.
+        const typename TestFixture::vector_type before = dcn::vee(dcn::log(dcn::transformation_difference(spline.evaluate(times[i] - h), poses[i]))) / h;
+        const typename TestFixture::vector_type after = dcn::vee(dcn::log(dcn::transformation_difference(poses[i], spline.evaluate(times[i] + h)))) / h;
+        for(int k = 0; k < 3; k++)
+        {
+            EXPECT_NEAR(before(k), twists[i](k), tol);
+            EXPECT_NEAR(after(k), twists[i](k), tol);
+        }
+    }
+}
+
+TYPED_TEST(DualComplexHermiteTest, reproduces_cubic_motion)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    // A translation and a rotation about the origin that both accelerate, which slerp cannot follow.
+    const auto translation = [](T t){ return dcn::translation(std::complex<T>(t * t * t - t, T(2) * t * t)); };
+    const auto rotation = [](T t){ return dcn::rotation(T(0.5) * t * t); };
+    const std::vector<T> times = { T(0), T(0.5), T(1.5), T(2) };
+
+    std::vector<dcn::DualComplex<T>> poses;
+    std::vector<typename TestFixture::vector_type> twists;
+    for(auto t : times)
+    {
+        poses.push_back(translation(t));
+        twists.push_back(typename TestFixture::vector_type(T(3) * t * t - T(1), T(4) * t, T(0)));
+    }
+    const dcn::HermiteSpline<T> moving(times.data(), poses.data(), twists.data(), times.size());
+
+    poses.clear();
+    twists.clear();
+    for(auto t : times)
+    {
+        poses.push_back(rotation(t));
+        twists.push_back(typename TestFixture::vector_type(T(0), T(0), t));
+    }
+    const dcn::HermiteSpline<T> turning(times.data(), poses.data(), twists.data(), times.size());
+
+    for(std::size_t k = 0; k <= 40; k++)
+    {
+        const auto t = T(0.05) * static_cast<T>(k);
+        pose_helper::expect_same_motion(moving.evaluate(t), translation(t), T(100) * atol);
+        pose_helper::expect_same_motion(turning.evaluate(t), rotation(t), T(100) * atol);
+    }
+}
+
+TYPED_TEST(DualComplexHermiteTest, follows_arc)
+{
+    using T = TypeParam;
+
+    // Driving on a circle of radius 2 with the body twist (1, 0, 0.5), keyed every second.
+    const auto arc = [](T t){ return pose_helper::make_pose(T(2) * std::sin(T(0.5) * t), T(2) - T(2) * std::cos(T(0.5) * t), T(0.5) * t); };
+    std::vector<T> times;
+    std::vector<dcn::DualComplex<T>> poses;
+    std::vector<typename TestFixture::vector_type> twists;
+    for(std::size_t i = 0; i <= 8; i++)
+    {
+        times.push_back(static_cast<T>(i));
+        poses.push_back(arc(times.back()));
+        twists.push_back(typename TestFixture::vector_type(T(1), T(0), T(0.5)));
+    }
+    const dcn::HermiteSpline<T> spline(times.data(), poses.data(), twists.data(), times.size());
+    for(std::size_t k = 0; k <= 80; k++)
+    {
+        const auto t = T(0.1) * static_cast<T>(k);
+        pose_helper::expect_same_motion(spline.evaluate(t), arc(t), T(1e-3));
+    }
+}
+
+TYPED_TEST(DualComplexHermiteTest, bulk_evaluate)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    std::vector<T> times;
+    std::vector<dcn::DualComplex<T>> poses;
+    std::vector<typename TestFixture::vector_type> twists;
+    TestFixture::make_keys(12, times, poses, twists);
+    const dcn::HermiteSpline<T> spline(times.data(), poses.data(), twists.data(), times.size());
+
+    // A sorted run, a jump back and times outside the range.
+    std::vector<T> queries;
+    for(std::size_t k = 0; k < 200; k++)
+        queries.push_back(spline.start_time() + (spline.end_time() - spline.start_time()) * static_cast<T>(k) / T(199));
+    queries.push_back(T(1));
+    queries.push_back(spline.start_time() - T(2));
+    queries.push_back(spline.end_time() + T(2));
+    queries.push_back(T(2));
+
+    queries.push_back(spline.end_time());
+    queries.push_back(T(0.5));
+
+    // The same values as the scalar path, with the last pose itself at and after the end.
+    std::vector<dcn::DualComplex<T>> out(queries.size());
+    spline.evaluate(queries.data(), queries.size(), out.data());
+    for(std::size_t k = 0; k < queries.size(); k++)
+    {
+        const auto expected = spline.evaluate(queries[k]);
+        EXPECT_EQ(out[k].real(), expected.real());
+        EXPECT_EQ(out[k].dual(), expected.dual());
+        pose_helper::expect_same_motion(out[k], expected, atol);
+    }
+    EXPECT_EQ(spline.evaluate(spline.end_time()).real(), poses.back().real());
+    EXPECT_EQ(spline.evaluate(spline.end_time()).dual(), poses.back().dual());
+}
+
+}   // namespace
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <random>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_query.h>
+#include <dualcomplex/dualcomplex_icp.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexIcpTest
+    : public ::testing::Test
+{
+protected:
+    static const T PI;
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-3f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-6; }
+
+    static std::vector<std::complex<T>> random_points(std::size_t count, unsigned seed)
+    {
+        std::mt19937 engine(seed);
+        std::uniform_real_distribution<T> dist(T(-10), T(10));
+
+        std::vector<std::complex<T>> res;
+        for(std::size_t i = 0; i < count; i++)
+        {
+            const auto x = dist(engine);
+            res.push_back(std::complex<T>(x, dist(engine)));
+        }
+        return res;
+    }
+
+    /**
+     * Points sampled along the walls of a rectangular room.
+     */
+    static std::vector<std::complex<T>> room(T step, T offset)
+    {
+        std::vector<std::complex<T>> res;
+        for(auto s = offset; s < T(8); s += step)
+        {
+            res.push_back(std::complex<T>(s, T(0)));
+            res.push_back(std::complex<T>(s, T(5)));
+        }
+        for(auto s = offset; s < T(5); s += step)
+        {
+            res.push_back(std::complex<T>(T(0), s));
+            res.push_back(std::complex<T>(T(8), s));
+        }
+        return res;
+    }
+};
+
+template<typename T>
+const T
+DualComplexIcpTest<T>::PI = std::acos(-T(1));
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexIcpTest, MyTypes);
+
+TYPED_TEST(DualComplexIcpTest, nearest)
+{
+    using C = std::complex<TypeParam>;
+    using Fixture = DualComplexIcpTest<TypeParam>;
+
+    const auto points = Fixture::random_points(200, 1);
+    const auto queries = Fixture::random_points(50, 2);
+    const dcn::PointKdTree<TypeParam> tree(points);
+
+    for(const auto& q : queries)
+    {
+        std::size_t expected = 0;
+        for(std::size_t i = 1; i < points.size(); i++)
+        {
+            if(std::norm(points[i] - q) < std::norm(points[expected] - q))
+                expected = i;
+        }
+        EXPECT_EQ(expected, tree.nearest(q));
+    }
+
+    // Out of range.
+    EXPECT_EQ(dcn::PointKdTree<TypeParam>::npos, tree.nearest(C(TypeParam(100), TypeParam(100)), nullptr, TypeParam(1)));
+}
+
+TYPED_TEST(DualComplexIcpTest, nearest_k)
+{
+    using Fixture = DualComplexIcpTest<TypeParam>;
+
+    const auto points = Fixture::random_points(200, 3);
+    const auto queries = Fixture::random_points(20, 4);
+    const dcn::PointKdTree<TypeParam> tree(points);
+
+    for(const auto& q : queries)
+    {
+        std::vector<std::size_t> expected(points.size());
+        for(std::size_t i = 0; i < expected.size(); i++)
+            expected[i] = i;
+        std::sort(expected.begin(), expected.end(),
+            [&](std::size_t a, std::size_t b){ return std::norm(points[a] - q) < std::norm(points[b] - q); });
+        expected.resize(7);
+
+        EXPECT_EQ(expected, tree.nearest_k(q, 7));
+    }
+}
+
+TYPED_TEST(DualComplexIcpTest, point_to_point)
+{
+    using C = std::complex<TypeParam>;
+    using DC = dcn::DualComplex<TypeParam>;
+    using Icp = dcn::IterativeClosestPoint<TypeParam>;
+    using Fixture = DualComplexIcpTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto target = Fixture::random_points(300, 6);
+    const auto truth = dcn::translation(C(TypeParam(0.3), TypeParam(-0.2))) * dcn::rotation(TypeParam(0.05));
+
+    std::vector<C> source(target.begin(), target.begin() + 100);
+    dcn::transform(inverse(truth), source.data(), source.size(), source.data());
+
+    const Icp icp(target);
+    const auto res = icp.align(source, DC(C(TypeParam(1), TypeParam(0)), C(TypeParam(0), TypeParam(0))));
+
+    EXPECT_TRUE(res.converged);
+    EXPECT_EQ(source.size(), res.correspondences);
+    EXPECT_TRUE(are_same(truth, res.transform, atol));
+}
+
+TYPED_TEST(DualComplexIcpTest, point_to_line)
+{
+    using C = std::complex<TypeParam>;
+    using DC = dcn::DualComplex<TypeParam>;
+    using Icp = dcn::IterativeClosestPoint<TypeParam>;
+    using Fixture = DualComplexIcpTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto target = Fixture::room(TypeParam(0.1), TypeParam(0.05));
+    const auto truth = dcn::translation(C(TypeParam(0.2), TypeParam(0.1))) * dcn::rotation(TypeParam(0.03));
+
+    // Sparse samples away from the corners, offset from the target samples.
+    std::vector<C> source;
+    for(const auto& p : Fixture::room(TypeParam(0.35), TypeParam(1)))
+    {
+        if(p.real() < TypeParam(7) && p.imag() < TypeParam(4))
+            source.push_back(p);
+    }
+    dcn::transform(inverse(truth), source.data(), source.size(), source.data());
+
+    Icp icp(target);
+    icp.estimate_target_normals(5);
+
+    typename Icp::Options options;
+    options.method = Icp::Method::PointToLine;
+    const auto res = icp.align(source, DC(C(TypeParam(1), TypeParam(0)), C(TypeParam(0), TypeParam(0))), options);
+
+    EXPECT_TRUE(res.converged);
+    EXPECT_TRUE(are_same(truth, res.transform, TypeParam(10) * atol));
+}
+
+}   // namespace
@@ -0,0 +1,107 @@
+// Built into its own test executable with DUALCOMPLEX_ENABLE_INSTRUMENTATION defined.
+#include <complex>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_interpolation.h>
+#include <dualcomplex/dualcomplex_instrumentation.h>
+
+namespace
+{
+
+double
+instrumented_sum(const std::vector<double>& values)
+{
+    DUALCOMPLEX_INSTRUMENT("test.instrumented_sum", values.size());
+
+    double res = 0.0;
+    for(auto v : values)
+        res += v;
+    return res;
+}
+
+TEST(DualComplexInstrumentationTest, counter)
+{
+    auto& registry = dcn::InstrumentationRegistry::instance();
+    auto& counter = registry.counter("test.counter");
+    EXPECT_EQ(&counter, &registry.counter("test.counter"));
+
+    counter.reset();
+    {
+        const dcn::ScopedTimer timer(counter, 10);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(std::uint64_t(1), counter.calls());
+    EXPECT_EQ(std::uint64_t(10), counter.elements());
+    EXPECT_GE(counter.nanoseconds(), std::uint64_t(1000000));
+
+    registry.reset();
+    EXPECT_EQ(std::uint64_t(0), counter.calls());
+}
+
+TEST(DualComplexInstrumentationTest, macro)
+{
+    auto& registry = dcn::InstrumentationRegistry::instance();
+    registry.counter("test.instrumented_sum").reset();
+
+    const std::vector<double> values(100, 1.0);
+    std::vector<std::thread> threads;
+    for(int i = 0; i < 4; i++)
+    {
+        threads.emplace_back([&values]()
+        {
+            for(int j = 0; j < 25; j++)
+                instrumented_sum(values);
+        });
+    }
+    for(auto& t : threads)
+        t.join();
+
+    const auto& counter = registry.counter("test.instrumented_sum");
+    EXPECT_EQ(std::uint64_t(100), counter.calls());
+    EXPECT_EQ(std::uint64_t(10000), counter.elements());
+}
+
+TEST(DualComplexInstrumentationTest, library)
+{
+    auto& registry = dcn::InstrumentationRegistry::instance();
+    registry.reset();
+
+    const auto p = dcn::translation(std::complex<double>(1.0, 2.0)) * dcn::rotation(0.5);
+    const auto q = dcn::rotation(-1.0);
+
+    const std::vector<std::complex<double>> points(16, std::complex<double>(1.0, 0.0));
+    std::vector<std::complex<double>> out(points.size());
+    dcn::transform(p, points.data(), points.size(), out.data());
+    dcn::slerp(p, q, 0.25);
+    dcn::slerp(p, q, 0.75);
+    dcn::dlb(std::vector<dcn::DualComplex<double>>({ p, q, q }), std::vector<double>({ 0.5, 0.25, 0.25 }));
+
+    EXPECT_EQ(std::uint64_t(1), registry.counter("transform_bulk").calls());
+    EXPECT_EQ(std::uint64_t(16), registry.counter("transform_bulk").elements());
+    EXPECT_EQ(std::uint64_t(2), registry.counter("slerp").calls());
+    EXPECT_EQ(std::uint64_t(1), registry.counter("dlb").calls());
+    EXPECT_EQ(std::uint64_t(3), registry.counter("dlb").elements());
+}
+
+TEST(DualComplexInstrumentationTest, report)
+{
+    auto& registry = dcn::InstrumentationRegistry::instance();
+    registry.reset();
+    registry.counter("test.report").add(3, 600);
+    registry.counter("test.unused");
+
+    std::ostringstream text;
+    registry.report_text(text);
+    EXPECT_NE(std::string::npos, text.str().find("test.report 1 3 600 200\n"));
+    EXPECT_EQ(std::string::npos, text.str().find("test.unused"));
+
+    std::ostringstream json;
+    registry.report_json(json);
+    EXPECT_EQ("{\"test.report\":{\"calls\":1,\"elements\":3,\"nanoseconds\":600}}", json.str());
+}
+
+}   // namespace
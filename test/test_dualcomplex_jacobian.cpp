@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_jacobian.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexJacobianTest
+    : public ::testing::Test
+{
+protected:
+    static const T PI;
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    numerical_step(){ return 1e-2f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    numerical_step(){ return 1e-5; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    numerical_tolerance(){ return 2e-3f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    numerical_tolerance(){ return 1e-7; }
+
+    static dcn::DualComplex<T> pose0()
+    {
+        return dcn::translation(std::complex<T>(T(1), T(2))) * dcn::rotation(PI / T(3));
+    }
+
+    static dcn::DualComplex<T> pose1()
+    {
+        return dcn::translation(std::complex<T>(T(-3), T(0.5))) * dcn::rotation(-PI / T(5));
+    }
+
+    static dcn::DualComplex<T> plus(const dcn::DualComplex<T>& dc, const Eigen::Matrix<T, 3, 1>& tau)
+    {
+        return dc * dcn::exp(dcn::hat(tau));
+    }
+
+    static Eigen::Matrix<T, 3, 1> minus(const dcn::DualComplex<T>& lhs, const dcn::DualComplex<T>& rhs)
+    {
+        return dcn::vee(dcn::log(dcn::inverse(rhs) * lhs));
+    }
+
+    /**
+     * Central differences of a function from tangent vectors to tangent vectors.
+     */
+    template<typename F>
+    static Eigen::Matrix<T, 3, 3> numerical_jacobian(F f)
+    {
+        const auto h = numerical_step();
+        Eigen::Matrix<T, 3, 3> m;
+        for(int i = 0; i < 3; i++)
+        {
+            Eigen::Matrix<T, 3, 1> delta = Eigen::Matrix<T, 3, 1>::Zero();
+            delta(i) = h;
+            m.col(i) = (f(delta) - f(-delta)) / (T(2) * h);
+        }
+        return m;
+    }
+};
+
+template<typename T>
+const T
+DualComplexJacobianTest<T>::PI = std::acos(-T(1));
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexJacobianTest, MyTypes);
+
+TYPED_TEST(DualComplexJacobianTest, hat_vee)
+{
+    using V = Eigen::Matrix<TypeParam, 3, 1>;
+    using Fixture = DualComplexJacobianTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto tau = V(TypeParam(1), TypeParam(-2), Fixture::PI / TypeParam(3));
+    const auto res = dcn::vee(dcn::log(dcn::exp(dcn::hat(tau))));
+
+    EXPECT_ALMOST_EQUAL(tau(0), res(0), atol);
+    EXPECT_ALMOST_EQUAL(tau(1), res(1), atol);
+    EXPECT_ALMOST_EQUAL(tau(2), res(2), atol);
+}
+
+TYPED_TEST(DualComplexJacobianTest, adjoint)
+{
+    using V = Eigen::Matrix<TypeParam, 3, 1>;
+    using Fixture = DualComplexJacobianTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+    constexpr auto ntol = Fixture::numerical_tolerance();
+
+    const auto dc = Fixture::pose0();
+
+    // dc * exp(delta) * inverse(dc) == exp(Ad * delta) to first order
+    auto expected = Fixture::numerical_jacobian(
+        [&](const V& delta){ return dcn::vee(dcn::log(Fixture::plus(dc, delta) * dcn::inverse(dc))); });
+    auto ad = dcn::adjoint(dc);
+
+    EXPECT_TRUE((expected - ad).norm() < ntol);
+    EXPECT_TRUE((ad * dcn::adjoint(dcn::inverse(dc))).isIdentity(atol));
+}
+
+TYPED_TEST(DualComplexJacobianTest, right_jacobian)
+{
+    using V = Eigen::Matrix<TypeParam, 3, 1>;
+    using Fixture = DualComplexJacobianTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+    constexpr auto ntol = Fixture::numerical_tolerance();
+
+    const auto tau = V(TypeParam(1), TypeParam(-2), TypeParam(0.7));
+    const auto x = dcn::exp(dcn::hat(tau));
+
+    auto expected = Fixture::numerical_jacobian(
+        [&](const V& delta){ return Fixture::minus(dcn::exp(dcn::hat(V(tau + delta))), x); });
+    auto jr = dcn::right_jacobian(tau);
+
+    EXPECT_TRUE((expected - jr).norm() < ntol);
+    EXPECT_TRUE((jr * dcn::inverse_right_jacobian(tau)).isIdentity(atol));
+}
+
+TYPED_TEST(DualComplexJacobianTest, left_jacobian)
+{
+    using V = Eigen::Matrix<TypeParam, 3, 1>;
+    using Fixture = DualComplexJacobianTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+    constexpr auto ntol = Fixture::numerical_tolerance();
+
+    const auto tau = V(TypeParam(1), TypeParam(-2), TypeParam(0.7));
+    const auto x = dcn::exp(dcn::hat(tau));
+
+    // exp(tau + delta) == exp(Jl * delta) * exp(tau)
+    auto expected = Fixture::numerical_jacobian(
+        [&](const V& delta)
+        {
+            return dcn::vee(dcn::log(dcn::exp(dcn::hat(V(tau + delta))) * dcn::inverse(x)));
+        });
+    auto jl = dcn::left_jacobian(tau);
+
+    EXPECT_TRUE((expected - jl).norm() < ntol);
+    EXPECT_TRUE((jl * dcn::inverse_left_jacobian(tau)).isIdentity(atol));
+    EXPECT_TRUE((dcn::adjoint(x) * dcn::right_jacobian(tau) - jl).norm() < atol);
+}
+
+TYPED_TEST(DualComplexJacobianTest, jacobian_of_inverse)
+{
+    using V = Eigen::Matrix<TypeParam, 3, 1>;
+    using Fixture = DualComplexJacobianTest<TypeParam>;
+
+    constexpr auto ntol = Fixture::numerical_tolerance();
+
+    const auto dc = Fixture::pose0();
+    const auto inv = dcn::inverse(dc);
+
+    auto expected = Fixture::numerical_jacobian(
+        [&](const V& delta){ return Fixture::minus(dcn::inverse(Fixture::plus(dc, delta)), inv); });
+
+    EXPECT_TRUE((expected - dcn::jacobian_of_inverse(dc)).norm() < ntol);
+}
+
+TYPED_TEST(DualComplexJacobianTest, jacobian_of_product)
+{
+    using V = Eigen::Matrix<TypeParam, 3, 1>;
+    using Fixture = DualComplexJacobianTest<TypeParam>;
+
+    constexpr auto ntol = Fixture::numerical_tolerance();
+
+    const auto lhs = Fixture::pose0();
+    const auto rhs = Fixture::pose1();
+    const auto prod = lhs * rhs;
+    // lhs
+    {
+        auto expected = Fixture::numerical_jacobian(
+            [&](const V& delta){ return Fixture::minus(Fixture::plus(lhs, delta) * rhs, prod); });
+
+        EXPECT_TRUE((expected - dcn::jacobian_of_product_lhs(lhs, rhs)).norm() < ntol);
+    }
+    // rhs
+    {
+        auto expected = Fixture::numerical_jacobian(
+            [&](const V& delta){ return Fixture::minus(lhs * Fixture::plus(rhs, delta), prod); });
+
+        EXPECT_TRUE((expected - dcn::jacobian_of_product_rhs(lhs, rhs)).norm() < ntol);
+    }
+}
+
+TYPED_TEST(DualComplexJacobianTest, jacobian_of_transform)
+{
+    using C = std::complex<TypeParam>;
+    using Fixture = DualComplexJacobianTest<TypeParam>;
+
+    constexpr auto ntol = Fixture::numerical_tolerance();
+    const auto h = Fixture::numerical_step();
+
+    const auto p = Fixture::pose0();
+    const auto v = C(TypeParam(3), TypeParam(-4));
+    // pose
+    {
+        Eigen::Matrix<TypeParam, 2, 3> expected;
+        for(int i = 0; i < 3; i++)
+        {
+            Eigen::Matrix<TypeParam, 3, 1> delta = Eigen::Matrix<TypeParam, 3, 1>::Zero();
+            delta(i) = h;
+            const auto diff = transform(Fixture::plus(p, delta), v)
+                            - transform(Fixture::plus(p, -delta), v);
+            expected(0, i) = diff.real() / (TypeParam(2) * h);
+            expected(1, i) = diff.imag() / (TypeParam(2) * h);
+        }
+
+        EXPECT_TRUE((expected - dcn::jacobian_of_transform_pose(p, v)).norm() < ntol);
+    }
+    // vector
+    {
+        Eigen::Matrix<TypeParam, 2, 2> expected;
+        const C dirs[] = { C(h, TypeParam(0)), C(TypeParam(0), h) };
+        for(int i = 0; i < 2; i++)
+        {
+            const auto diff = transform(p, v + dirs[i]) - transform(p, v - dirs[i]);
+            expected(0, i) = diff.real() / (TypeParam(2) * h);
+            expected(1, i) = diff.imag() / (TypeParam(2) * h);
+        }
+
+        EXPECT_TRUE((expected - dcn::jacobian_of_transform_vector(p, v)).norm() < ntol);
+    }
+}
+
+TYPED_TEST(DualComplexJacobianTest, jacobian_of_log_exp)
+{
+    using V = Eigen::Matrix<TypeParam, 3, 1>;
+    using Fixture = DualComplexJacobianTest<TypeParam>;
+
+    constexpr auto ntol = Fixture::numerical_tolerance();
+
+    // log
+    {
+        const auto dc = Fixture::pose1();
+        const auto tau = dcn::vee(dcn::log(dc));
+
+        Eigen::Matrix<TypeParam, 3, 3> expected = Fixture::numerical_jacobian(
+            [&](const V& delta){ return V(dcn::vee(dcn::log(Fixture::plus(dc, delta))) - tau); });
+
+        EXPECT_TRUE((expected - dcn::jacobian_of_log(dc)).norm() < ntol);
+    }
+    // exp
+    {
+        const auto tau = V(TypeParam(-0.5), TypeParam(2), TypeParam(1.2));
+        const auto x = dcn::exp(dcn::hat(tau));
+
+        auto expected = Fixture::numerical_jacobian(
+            [&](const V& delta){ return Fixture::minus(dcn::exp(dcn::hat(V(tau + delta))), x); });
+
+        EXPECT_TRUE((expected - dcn::jacobian_of_exp(tau)).norm() < ntol);
+    }
+}
+
+}   // namespace
@@ -0,0 +1,142 @@
+#include <random>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_interpolation.h>
+#include <dualcomplex/dualcomplex_query.h>
+#include <dualcomplex/dualcomplex_mixed_precision.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+class DualComplexMixedPrecisionTest
+    : public ::testing::Test
+{
+protected:
+    static std::vector<dcn::DualComplex<double>> make_poses(std::size_t count, std::uint32_t seed, double scale)
+    {
+        std::mt19937 engine(seed);
+        std::uniform_real_distribution<double> dist(-scale, scale);
+
+        std::vector<dcn::DualComplex<double>> poses;
+        for(std::size_t i = 0; i < count; i++)
+        {
+            const auto x = dist(engine);
+            const auto y = dist(engine);
+            poses.push_back(dcn::translation(std::complex<double>(x, y)) * dcn::rotation(dist(engine)));
+        }
+        return poses;
+    }
+
+    template<typename S>
+    static std::vector<dcn::DualComplex<S>> convert(const std::vector<dcn::DualComplex<double>>& dcs)
+    {
+        std::vector<dcn::DualComplex<S>> res;
+        for(const auto& dc : dcs)
+            res.push_back(dcn::DualComplex<S>(dc));
+        return res;
+    }
+};
+
+TEST_F(DualComplexMixedPrecisionTest, converting_constructor)
+{
+    const auto d = dcn::DualComplex<double>(0.1, 0.2, 0.3, 0.4);
+    const auto f = dcn::DualComplex<float>(d);
+    EXPECT_EQ(0.1f, f.real().real());
+    EXPECT_EQ(0.2f, f.real().imag());
+    EXPECT_EQ(0.3f, f.dual().real());
+    EXPECT_EQ(0.4f, f.dual().imag());
+
+    const auto g = dcn::DualComplex<double>(f);
+    EXPECT_EQ(static_cast<double>(0.1f), g.real().real());
+    EXPECT_EQ(static_cast<double>(0.4f), g.dual().imag());
+}
+
+TEST_F(DualComplexMixedPrecisionTest, bfloat16)
+{
+    EXPECT_EQ(1.0f, dcn::to_float(dcn::to_bfloat16(1.0f)));
+    EXPECT_EQ(-2.5f, dcn::to_float(dcn::to_bfloat16(-2.5f)));
+    EXPECT_TRUE(std::isnan(dcn::to_float(dcn::to_bfloat16(std::numeric_limits<float>::quiet_NaN()))));
+    EXPECT_TRUE(std::isinf(dcn::to_float(dcn::to_bfloat16(std::numeric_limits<float>::infinity()))));
+    // Ties round to even: 1 + 2^-8 lies halfway between 1 and 1 + 2^-7.
+    EXPECT_EQ(1.0f, dcn::to_float(dcn::to_bfloat16(1.0f + 1.0f / 256.0f)));
+    EXPECT_EQ(1.0f + 1.0f / 64.0f, dcn::to_float(dcn::to_bfloat16(1.0f + 3.0f / 256.0f)));
+
+    std::mt19937 engine(1);
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+    for(int i = 0; i < 1000; i++)
+    {
+        const auto x = dist(engine);
+        EXPECT_NEAR(x, dcn::to_float(dcn::to_bfloat16(x)), std::abs(x) / 256.0f);
+    }
+
+    const auto p = dcn::translation(std::complex<double>(1.5, -0.5)) * dcn::rotation(0.7);
+    const auto q = dcn::unpack<double>(dcn::pack(p));
+    EXPECT_TRUE(almost_equal(p, q, 1e-2));
+    EXPECT_EQ(std::size_t(8), sizeof(dcn::PackedDualComplex));
+}
+
+TEST_F(DualComplexMixedPrecisionTest, accumulate_dlb)
+{
+    const auto transforms = make_poses(10000, 2, 1.0);
+    std::vector<double> weights(transforms.size(), 1.0 / static_cast<double>(transforms.size()));
+    const auto expected = dcn::dlb(transforms, weights);
+
+    const auto ftransforms = convert<float>(transforms);
+    const std::vector<float> fweights(weights.begin(), weights.end());
+    const auto res = dcn::accumulate_dlb(ftransforms.data(), fweights.data(), ftransforms.size());
+
+    EXPECT_TRUE(almost_equal(expected, res, 1e-6));
+
+    std::vector<dcn::PackedDualComplex> packed;
+    for(const auto& dc : transforms)
+        packed.push_back(dcn::pack(dc));
+    EXPECT_TRUE(almost_equal(expected, dcn::accumulate_dlb(packed.data(), weights.data(), packed.size()), 1e-2));
+}
+
+TEST_F(DualComplexMixedPrecisionTest, accumulate_composition)
+{
+    const auto transforms = make_poses(10000, 3, 0.01);
+    std::vector<dcn::DualComplex<double>> expected(transforms.size());
+    dcn::accumulate_composition(transforms.data(), transforms.size(), expected.data());
+
+    auto ftransforms = convert<float>(transforms);
+    std::vector<dcn::DualComplex<float>> res(ftransforms.size());
+    dcn::accumulate_composition(ftransforms.data(), ftransforms.size(), res.data());
+
+    // Accumulating in float drifts further from the double result.
+    auto naive = dcn::DualComplex<float>(1.0f, 0.0f, 0.0f, 0.0f);
+    for(const auto& dc : ftransforms)
+        naive *= dc;
+
+    const auto error = [](const dcn::DualComplex<double>& a, const dcn::DualComplex<double>& b)
+    {
+        return std::abs(dcn::transform(a, std::complex<double>(0.0)) - dcn::transform(b, std::complex<double>(0.0)));
+    };
+    const auto& last = expected.back();
+    const auto accumulated_error = error(last, dcn::DualComplex<double>(res.back()));
+    EXPECT_LT(accumulated_error, 1e-4);
+    EXPECT_LT(accumulated_error, error(last, dcn::DualComplex<double>(naive)));
+
+    // In place.
+    dcn::accumulate_composition(ftransforms.data(), ftransforms.size(), ftransforms.data());
+    EXPECT_EQ(res.back().real(), ftransforms.back().real());
+    EXPECT_EQ(res.back().dual(), ftransforms.back().dual());
+}
+
+TEST_F(DualComplexMixedPrecisionTest, accumulate_mean)
+{
+    const auto center = dcn::translation(std::complex<double>(1.0, 2.0)) * dcn::rotation(0.5);
+    std::vector<dcn::DualComplex<float>> transforms;
+    for(int i = -50; i <= 50; i++)
+    {
+        const auto p = center * dcn::rotation(0.001 * i);
+        transforms.push_back(dcn::DualComplex<float>((i % 2 == 0) ? p : -p));
+    }
+
+    const auto res = dcn::accumulate_mean(transforms.data(), transforms.size());
+    EXPECT_TRUE(are_same(center, res, 1e-6));
+}
+
+}   // namespace
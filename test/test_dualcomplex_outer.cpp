@@ -0,0 +1,99 @@
+#include <random>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_outer.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexOuterTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    static std::vector<dcn::DualComplex<T>> make_values(std::size_t count, std::uint32_t seed)
+    {
+        std::mt19937 engine(seed);
+        std::uniform_real_distribution<T> dist(T(-3), T(3));
+
+        std::vector<dcn::DualComplex<T>> dcs;
+        for(std::size_t i = 0; i < count; i++)
+        {
+            const auto x = dist(engine);
+            const auto y = dist(engine);
+            dcs.push_back(dcn::translation(std::complex<T>(x, y)) * dcn::rotation(dist(engine)));
+        }
+        return dcs;
+    }
+
+    static void expect_near(const dcn::DualComplex<T>& lhs, const dcn::DualComplex<T>& rhs)
+    {
+        EXPECT_COMPLEX_ALMOST_EQUAL(lhs.real(), rhs.real(), absolute_tolerance());
+        EXPECT_COMPLEX_ALMOST_EQUAL(lhs.dual(), rhs.dual(), absolute_tolerance());
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexOuterTest, MyTypes);
+
+TYPED_TEST(DualComplexOuterTest, compose_outer)
+{
+    using T = TypeParam;
+
+    // Sizes that are not multiples of the tile.
+    const auto lhs = TestFixture::make_values(37, 1);
+    const auto rhs = TestFixture::make_values(300, 2);
+
+    for(unsigned num_threads : { 1u, 3u, 0u })
+    {
+        std::vector<dcn::DualComplex<T>> out(lhs.size() * rhs.size());
+        dcn::compose_outer(lhs.data(), lhs.size(), rhs.data(), rhs.size(), out.data(), num_threads);
+        for(std::size_t i = 0; i < lhs.size(); i++)
+        {
+            for(std::size_t j = 0; j < rhs.size(); j++)
+                TestFixture::expect_near(out[i * rhs.size() + j], lhs[i] * rhs[j]);
+        }
+    }
+}
+
+TYPED_TEST(DualComplexOuterTest, transformation_difference_outer)
+{
+    using T = TypeParam;
+
+    const auto lhs = TestFixture::make_values(5, 3);
+    const auto rhs = TestFixture::make_values(513, 4);
+
+    for(unsigned num_threads : { 1u, 4u })
+    {
+        std::vector<dcn::DualComplex<T>> out(lhs.size() * rhs.size());
+        dcn::transformation_difference_outer(lhs.data(), lhs.size(), rhs.data(), rhs.size(), out.data(), num_threads);
+        for(std::size_t i = 0; i < lhs.size(); i++)
+        {
+            for(std::size_t j = 0; j < rhs.size(); j++)
+                TestFixture::expect_near(out[i * rhs.size() + j], dcn::transformation_difference(lhs[i], rhs[j]));
+        }
+    }
+}
+
+TYPED_TEST(DualComplexOuterTest, empty)
+{
+    using T = TypeParam;
+
+    const auto lhs = TestFixture::make_values(3, 5);
+    std::vector<dcn::DualComplex<T>> out(1, dcn::DualComplex<T>(T(7), T(7), T(7), T(7)));
+    dcn::compose_outer(lhs.data(), lhs.size(), lhs.data(), 0, out.data(), 2);
+    dcn::compose_outer(lhs.data(), 0, lhs.data(), lhs.size(), out.data(), 2);
+    EXPECT_EQ(out[0].real().real(), T(7));
+}
+
+}   // namespace
@@ -0,0 +1,206 @@
+#include <thread>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_pipeline.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexPipelineTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    static std::vector<T> make_headings(std::size_t count)
+    {
+        std::vector<T> angles;
+        for(std::size_t i = 0; i < count; i++)
+            angles.push_back(static_cast<T>(i % 101) * T(0.05) - T(2.5));
+        return angles;
+    }
+
+    static dcn::DualComplex<T> sensor()
+    {
+        return dcn::translation(std::complex<T>(T(1), T(-2))) * dcn::rotation(T(0.3));
+    }
+
+    static void expect_near(const std::vector<dcn::DualComplex<T>>& lhs, const std::vector<dcn::DualComplex<T>>& rhs)
+    {
+        ASSERT_EQ(lhs.size(), rhs.size());
+        for(std::size_t i = 0; i < lhs.size(); i++)
+        {
+            EXPECT_COMPLEX_ALMOST_EQUAL(lhs[i].real(), rhs[i].real(), absolute_tolerance());
+            EXPECT_COMPLEX_ALMOST_EQUAL(lhs[i].dual(), rhs[i].dual(), absolute_tolerance());
+        }
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexPipelineTest, MyTypes);
+
+TEST(SpscQueueTest, single_thread)
+{
+    dcn::SpscQueue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 4u);
+
+    for(int i = 0; i < 4; i++)
+        EXPECT_TRUE(queue.try_push(i));
+    EXPECT_FALSE(queue.try_push(4));
+
+    int value = -1;
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(queue.try_push(4));
+
+    queue.close();
+    for(int i = 1; i < 5; i++)
+    {
+        EXPECT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.pop(value));
+}
+
+TEST(SpscQueueTest, two_threads)
+{
+    dcn::SpscQueue<int> queue(16);
+    const int count = 100000;
+
+    std::thread producer([&]()
+    {
+        for(int i = 0; i < count; i++)
+            queue.push(i);
+        queue.close();
+    });
+
+    int expected = 0;
+    int value;
+    while(queue.pop(value))
+    {
+        if(value != expected)
+            break;
+        expected++;
+    }
+    producer.join();
+    EXPECT_EQ(expected, count);
+}
+
+TYPED_TEST(DualComplexPipelineTest, fused)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    const auto angles = TestFixture::make_headings(1000);
+    std::vector<dcn::DualComplex<T>> expected;
+    for(auto angle : angles)
+        expected.push_back(dcn::normalize(TestFixture::sensor() * dcn::rotation(angle) * TestFixture::sensor()));
+
+    dcn::PosePipeline<T> pipeline(64);
+    pipeline.then(dcn::compose_left_stage(TestFixture::sensor()))
+            .then(dcn::compose_right_stage(TestFixture::sensor()))
+            .then(dcn::normalize_stage<T>())
+            .then(dcn::unit_filter_stage(atol));
+    EXPECT_EQ(pipeline.num_segments(), 1u);
+
+    std::vector<dcn::DualComplex<T>> res;
+    pipeline.run(dcn::rotation_source(angles.data(), angles.size()), dcn::append_sink(res));
+    TestFixture::expect_near(res, expected);
+
+    // An empty source.
+    res.clear();
+    pipeline.run(dcn::rotation_source(angles.data(), 0), dcn::append_sink(res));
+    EXPECT_TRUE(res.empty());
+}
+
+TYPED_TEST(DualComplexPipelineTest, filter)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    std::vector<dcn::DualComplex<T>> input;
+    std::vector<dcn::DualComplex<T>> expected;
+    for(std::size_t i = 0; i < 300; i++)
+    {
+        const auto dc = dcn::rotation(static_cast<T>(i) * T(0.01));
+        input.push_back((i % 3 == 0) ? dc * T(2) : dc);
+        if(i % 3 != 0)
+            expected.push_back(dc);
+    }
+
+    dcn::PosePipeline<T> pipeline(50);
+    pipeline.then(dcn::unit_filter_stage(atol));
+
+    std::vector<dcn::DualComplex<T>> res;
+    pipeline.run(dcn::array_source(input.data(), input.size()), dcn::append_sink(res));
+    TestFixture::expect_near(res, expected);
+}
+
+TYPED_TEST(DualComplexPipelineTest, smoothing_across_chunks)
+{
+    using T = TypeParam;
+
+    const auto angles = TestFixture::make_headings(500);
+
+    std::vector<dcn::DualComplex<T>> whole;
+    dcn::PosePipeline<T> single(angles.size());
+    single.then(dcn::smoothing_stage(T(0.25)));
+    single.run(dcn::rotation_source(angles.data(), angles.size()), dcn::append_sink(whole));
+
+    std::vector<dcn::DualComplex<T>> chunked;
+    dcn::PosePipeline<T> small(7);
+    small.then(dcn::smoothing_stage(T(0.25)));
+    small.run(dcn::rotation_source(angles.data(), angles.size()), dcn::append_sink(chunked));
+
+    TestFixture::expect_near(chunked, whole);
+}
+
+TYPED_TEST(DualComplexPipelineTest, concurrent)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    const auto angles = TestFixture::make_headings(5000);
+
+    std::vector<dcn::DualComplex<T>> expected;
+    dcn::PosePipeline<T> fused(32);
+    fused.then(dcn::compose_left_stage(TestFixture::sensor()))
+         .then(dcn::smoothing_stage(T(0.5)))
+         .then(dcn::normalize_stage<T>())
+         .then(dcn::unit_filter_stage(atol));
+    fused.run(dcn::rotation_source(angles.data(), angles.size()), dcn::append_sink(expected));
+
+    dcn::PosePipeline<T> threaded(32, 2);
+    threaded.then(dcn::compose_left_stage(TestFixture::sensor()))
+            .split()
+            .split()    // Does not add an empty segment.
+            .then(dcn::smoothing_stage(T(0.5)))
+            .split()
+            .then(dcn::normalize_stage<T>())
+            .then(dcn::unit_filter_stage(atol));
+    EXPECT_EQ(threaded.num_segments(), 3u);
+
+    std::vector<dcn::DualComplex<T>> res;
+    threaded.run(dcn::rotation_source(angles.data(), angles.size()), dcn::append_sink(res));
+    TestFixture::expect_near(res, expected);
+
+    // process() runs the stages in place on a single chunk, without a source or a sink.
+    std::vector<dcn::DualComplex<T>> chunk;
+    for(std::size_t i = 0; i < 3; i++)
+        chunk.push_back(dcn::rotation(angles[i]));
+    dcn::PosePipeline<T> direct;
+    direct.then(dcn::compose_left_stage(TestFixture::sensor()));
+    direct.process(chunk);
+    EXPECT_COMPLEX_ALMOST_EQUAL(chunk[2].real(), (TestFixture::sensor() * dcn::rotation(angles[2])).real(), atol);
+}
+
+}   // namespace
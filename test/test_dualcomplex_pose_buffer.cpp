@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_query.h>
+#include <dualcomplex/dualcomplex_interpolation.h>
+#include <dualcomplex/dualcomplex_pose_buffer.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexPoseBufferTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    /**
+     * Pose at the i-th entry, including turns of more than a half revolution between neighbours.
+     */
+    static dcn::DualComplex<T> make_pose(std::size_t i)
+    {
+        const auto x = static_cast<T>(i);
+        return dcn::translation(std::complex<T>(x, T(0.5) * x)) * dcn::rotation(T(2.1) * x);
+    }
+
+    static void expect_near(const dcn::DualComplex<T>& lhs, const dcn::DualComplex<T>& rhs)
+    {
+        EXPECT_COMPLEX_ALMOST_EQUAL(lhs.real(), rhs.real(), absolute_tolerance());
+        EXPECT_COMPLEX_ALMOST_EQUAL(lhs.dual(), rhs.dual(), absolute_tolerance());
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexPoseBufferTest, MyTypes);
+
+TYPED_TEST(DualComplexPoseBufferTest, insert)
+{
+    using T = TypeParam;
+
+    dcn::PoseBuffer<T> buffer(4);
+    double oldest, newest;
+    EXPECT_FALSE(buffer.time_range(oldest, newest));
+
+    for(std::size_t i = 0; i < 6; i++)
+        EXPECT_TRUE(buffer.insert(static_cast<double>(i), TestFixture::make_pose(i)));
+    EXPECT_FALSE(buffer.insert(5.0, TestFixture::make_pose(0)));
+    EXPECT_FALSE(buffer.insert(1.0, TestFixture::make_pose(0)));
+
+    // The two oldest entries were overwritten.
+    EXPECT_EQ(buffer.size(), 4u);
+    EXPECT_TRUE(buffer.time_range(oldest, newest));
+    EXPECT_EQ(oldest, 2.0);
+    EXPECT_EQ(newest, 5.0);
+
+    buffer.clear();
+    EXPECT_EQ(buffer.size(), 0u);
+    dcn::DualComplex<T> pose;
+    EXPECT_FALSE(buffer.lookup(3.0, pose));
+}
+
+TYPED_TEST(DualComplexPoseBufferTest, lookup)
+{
+    using T = TypeParam;
+
+    dcn::PoseBuffer<T> buffer(8);
+    for(std::size_t i = 0; i < 11; i++)
+        buffer.insert(0.125 * static_cast<double>(i), TestFixture::make_pose(i));
+
+    dcn::DualComplex<T> pose;
+    EXPECT_FALSE(buffer.lookup(0.25, pose));
+    EXPECT_FALSE(buffer.lookup(1.26, pose));
+
+    EXPECT_TRUE(buffer.lookup(0.375, pose));
+    TestFixture::expect_near(pose, TestFixture::make_pose(3));
+    EXPECT_TRUE(buffer.lookup(1.25, pose));
+    TestFixture::expect_near(pose, TestFixture::make_pose(10));
+
+    for(std::size_t i = 3; i < 10; i++)
+    {
+        for(auto t : { T(0.25), T(0.5), T(0.9) })
+        {
+            EXPECT_TRUE(buffer.lookup(0.125 * (static_cast<double>(i) + static_cast<double>(t)), pose));
+            const auto expected = dcn::slerp_shortestpath(TestFixture::make_pose(i), TestFixture::make_pose(i + 1), t);
+            TestFixture::expect_near(pose, expected);
+        }
+    }
+}
+
+TYPED_TEST(DualComplexPoseBufferTest, batch_lookup)
+{
+    using T = TypeParam;
+
+    dcn::PoseBuffer<T> buffer(100);
+    for(std::size_t i = 0; i < 130; i++)
+        buffer.insert(static_cast<double>(i), TestFixture::make_pose(i));
+
+    std::mt19937 engine(3);
+    std::uniform_real_distribution<double> dist(20.0, 135.0);
+    std::vector<double> unsorted;
+    for(std::size_t i = 0; i < 500; i++)
+        unsorted.push_back(dist(engine));
+    auto sorted = unsorted;
+    std::sort(sorted.begin(), sorted.end());
+
+    for(const auto* times : { &sorted, &unsorted })
+    {
+        std::vector<dcn::DualComplex<T>> poses(times->size());
+        std::vector<std::uint64_t> mask(dcn::mask_words(times->size()));
+        const auto found = buffer.lookup(times->data(), times->size(), poses.data(), mask.data());
+
+        std::size_t expected_found = 0;
+        for(std::size_t k = 0; k < times->size(); k++)
+        {
+            dcn::DualComplex<T> expected;
+            const auto ok = buffer.lookup((*times)[k], expected);
+            EXPECT_EQ(((mask[k / 64] >> (k % 64)) & 1u) != 0, ok);
+            if(ok)
+            {
+                TestFixture::expect_near(poses[k], expected);
+                expected_found++;
+            }
+        }
+        EXPECT_EQ(found, expected_found);
+        EXPECT_GT(found, 0u);
+        EXPECT_LT(found, times->size());
+    }
+
+    // Without a mask.
+    std::vector<dcn::DualComplex<T>> poses(sorted.size());
+    EXPECT_GT(buffer.lookup(sorted.data(), sorted.size(), poses.data(), nullptr), 0u);
+}
+
+TYPED_TEST(DualComplexPoseBufferTest, integer_time)
+{
+    using T = TypeParam;
+
+    dcn::PoseBuffer<T, std::int64_t> buffer(4);
+    buffer.insert(1000000, TestFixture::make_pose(0));
+    buffer.insert(2000000, TestFixture::make_pose(1));
+
+    dcn::DualComplex<T> pose;
+    EXPECT_TRUE(buffer.lookup(1250000, pose));
+    TestFixture::expect_near(pose, dcn::slerp_shortestpath(TestFixture::make_pose(0), TestFixture::make_pose(1), T(0.25)));
+}
+
+TYPED_TEST(DualComplexPoseBufferTest, concurrent)
+{
+    using T = TypeParam;
+
+    dcn::PoseBuffer<T> buffer(64);
+    std::atomic<bool> done(false);
+    std::atomic<std::size_t> errors(0);
+
+    std::vector<std::thread> readers;
+    for(int r = 0; r < 3; r++)
+    {
+        readers.emplace_back([&]()
+        {
+            std::vector<double> times(200);
+            std::vector<dcn::DualComplex<T>> poses(times.size());
+            do
+            {
+                double oldest, newest;
+                if(!buffer.time_range(oldest, newest))
+                    continue;
+                for(std::size_t k = 0; k < times.size(); k++)
+                    times[k] = oldest + (newest - oldest) * static_cast<double>(k) / static_cast<double>(times.size());
+                buffer.lookup(times.data(), times.size(), poses.data(), nullptr);
+                for(const auto& pose : poses)
+                {
+                    if(!dcn::is_unit(pose, TestFixture::absolute_tolerance()))
+                        errors++;
+                }
+            }
+            while(!done.load());
+        });
+    }
+
+    for(std::size_t i = 0; i < 2000; i++)
+        buffer.insert(static_cast<double>(i), TestFixture::make_pose(i));
+    done.store(true);
+    for(auto& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(errors.load(), 0u);
+}
+
+}   // namespace
@@ -0,0 +1,166 @@
+#include <random>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_pose_index.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexPoseIndexTest
+    : public ::testing::Test
+{
+protected:
+    static const T PI;
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    static std::vector<dcn::DualComplex<T>> make_poses(std::size_t count, std::uint32_t seed)
+    {
+        std::mt19937 engine(seed);
+        std::uniform_real_distribution<T> position(T(-5), T(5));
+        std::uniform_real_distribution<T> angle(-PI, PI);
+
+        std::vector<dcn::DualComplex<T>> poses;
+        for(std::size_t i = 0; i < count; i++)
+        {
+            const auto x = position(engine);
+            const auto y = position(engine);
+            const auto pose = dcn::translation(std::complex<T>(x, y)) * dcn::rotation(angle(engine));
+            // Store either sign.
+            poses.push_back((i % 2 == 0) ? pose : -pose);
+        }
+        return poses;
+    }
+};
+
+template<typename T>
+const T
+DualComplexPoseIndexTest<T>::PI = std::acos(-T(1));
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexPoseIndexTest, MyTypes);
+
+TYPED_TEST(DualComplexPoseIndexTest, pose_distance)
+{
+    using C = std::complex<TypeParam>;
+    using Fixture = DualComplexPoseIndexTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto p = dcn::translation(C(TypeParam(1), TypeParam(2))) * dcn::rotation(TypeParam(3));
+    const auto q = dcn::translation(C(TypeParam(4), TypeParam(6))) * dcn::rotation(-TypeParam(3));
+
+    EXPECT_NEAR(TypeParam(0), dcn::pose_distance(p, -p, TypeParam(1)), atol);
+    EXPECT_NEAR(TypeParam(5), dcn::pose_distance(p, q, TypeParam(0)), atol);
+    // The angle difference wraps around: 6 - 2 pi.
+    const auto da = TypeParam(2) * Fixture::PI - TypeParam(6);
+    EXPECT_NEAR(std::sqrt(TypeParam(25) + TypeParam(4) * da * da), dcn::pose_distance(p, -q, TypeParam(2)), atol);
+}
+
+TYPED_TEST(DualComplexPoseIndexTest, radius_query)
+{
+    using Fixture = DualComplexPoseIndexTest<TypeParam>;
+    using Index = dcn::PoseIndex<TypeParam>;
+
+    const auto poses = Fixture::make_poses(2000, 1);
+    const auto queries = Fixture::make_poses(50, 2);
+    const auto radius = TypeParam(0.7);
+    const auto weight = TypeParam(0.5);
+
+    Index index(radius, weight);
+    for(const auto& pose : poses)
+        index.insert(pose);
+    ASSERT_EQ(poses.size(), index.size());
+
+    std::size_t total = 0;
+    for(const auto& query : queries)
+    {
+        std::vector<std::size_t> expected;
+        for(std::size_t i = 0; i < poses.size(); i++)
+        {
+            if(dcn::pose_distance(query, poses[i], weight) <= radius)
+                expected.push_back(i);
+        }
+        EXPECT_EQ(expected, index.radius_query(query, radius));
+        EXPECT_EQ(expected, index.radius_query(-query, radius));
+        // Larger than the cell size.
+        std::vector<std::size_t> wide;
+        for(std::size_t i = 0; i < poses.size(); i++)
+        {
+            if(dcn::pose_distance(query, poses[i], weight) <= TypeParam(2) * radius)
+                wide.push_back(i);
+        }
+        EXPECT_EQ(wide, index.radius_query(query, TypeParam(2) * radius));
+        total += expected.size();
+    }
+    EXPECT_GT(total, std::size_t(0));
+}
+
+TYPED_TEST(DualComplexPoseIndexTest, nearest)
+{
+    using Fixture = DualComplexPoseIndexTest<TypeParam>;
+    using Index = dcn::PoseIndex<TypeParam>;
+
+    const auto poses = Fixture::make_poses(1000, 3);
+    const auto queries = Fixture::make_poses(50, 4);
+
+    Index index(TypeParam(0.25));
+    EXPECT_EQ(Index::npos, index.nearest(queries[0]));
+    for(const auto& pose : poses)
+        index.insert(pose);
+
+    for(const auto& query : queries)
+    {
+        auto expected = Index::npos;
+        auto expected_distance = std::numeric_limits<TypeParam>::infinity();
+        for(std::size_t i = 0; i < poses.size(); i++)
+        {
+            const auto d = dcn::pose_distance(query, poses[i], TypeParam(1));
+            if(d < expected_distance)
+            {
+                expected_distance = d;
+                expected = i;
+            }
+        }
+        TypeParam distance;
+        EXPECT_EQ(expected, index.nearest(-query, &distance));
+        EXPECT_NEAR(expected_distance, distance, Fixture::absolute_tolerance());
+        EXPECT_EQ(Index::npos, index.nearest(query, nullptr, expected_distance * TypeParam(0.5)));
+    }
+
+    // Far outside the occupied region.
+    const auto far = dcn::translation(std::complex<TypeParam>(TypeParam(100), TypeParam(0)));
+    EXPECT_NE(Index::npos, index.nearest(far));
+}
+
+TYPED_TEST(DualComplexPoseIndexTest, insert_unique)
+{
+    using C = std::complex<TypeParam>;
+    using Index = dcn::PoseIndex<TypeParam>;
+
+    Index index(TypeParam(0.1));
+    const auto p = dcn::translation(C(TypeParam(1), TypeParam(1))) * dcn::rotation(TypeParam(0.5));
+
+    const auto r0 = index.insert_unique(p, TypeParam(0.05));
+    EXPECT_TRUE(r0.second);
+    const auto r1 = index.insert_unique(-p, TypeParam(0.05));
+    EXPECT_FALSE(r1.second);
+    EXPECT_EQ(r0.first, r1.first);
+    const auto r2 = index.insert_unique(dcn::translation(C(TypeParam(0.1), TypeParam(0))) * p, TypeParam(0.05));
+    EXPECT_TRUE(r2.second);
+    EXPECT_EQ(std::size_t(2), index.size());
+
+    index.clear();
+    EXPECT_TRUE(index.empty());
+}
+
+}   // namespace
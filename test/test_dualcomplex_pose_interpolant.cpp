@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_query.h>
+#include <dualcomplex/dualcomplex_interpolation.h>
+#include <dualcomplex/dualcomplex_pose_interpolant.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexPoseInterpolantTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-5f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-12; }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexPoseInterpolantTest, MyTypes);
+
+TYPED_TEST(DualComplexPoseInterpolantTest, shortest_difference)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    const auto p0 = dcn::translation(std::complex<T>(T(1), T(-2))) * dcn::rotation(T(0.4));
+    const auto p1 = dcn::translation(std::complex<T>(T(3), T(1))) * dcn::rotation(T(2.9));
+    for(const auto& q : { p1, -p1 })
+    {
+        const auto diff = dcn::detail::shortest_difference(p0, q);
+        EXPECT_GE(diff.real().real(), T(0));
+        EXPECT_TRUE(dcn::are_same(dcn::transformation_difference(p0, p1), diff, atol));
+
+        const dcn::detail::PoseInterpolant<T> interpolant(p0, q);
+        for(auto t : { T(0), T(0.3), T(1) })
+        {
+            const auto expected = dcn::slerp_shortestpath(p0, q, t);
+            const auto res = interpolant.evaluate(t);
+            EXPECT_COMPLEX_ALMOST_EQUAL(res.real(), expected.real(), T(10) * atol);
+            EXPECT_COMPLEX_ALMOST_EQUAL(res.dual(), expected.dual(), T(10) * atol);
+        }
+    }
+}
+
+TYPED_TEST(DualComplexPoseInterpolantTest, find_segment)
+{
+    using T = TypeParam;
+
+    const std::vector<T> times = { T(0), T(1), T(1.5), T(3), T(4), T(4.5), T(7), T(8), T(10) };
+    const auto last = times.size() - 2;
+    const auto expected = [&](T time)
+    {
+        const auto it = std::upper_bound(times.begin() + 1, times.end() - 1, time);
+        return static_cast<std::size_t>(it - times.begin()) - 1;
+    };
+
+    // Sorted and random times, including the keys and times outside the range, from every hint.
+    std::mt19937 engine(3);
+    std::uniform_real_distribution<T> dist(T(-1), T(11));
+    std::vector<T> queries(times);
+    queries.push_back(T(-5));
+    queries.push_back(T(20));
+    for(int k = 0; k < 100; k++)
+        queries.push_back(dist(engine));
+
+    for(auto time : queries)
+    {
+        for(std::size_t hint = 0; hint <= last; hint++)
+            EXPECT_EQ(dcn::detail::find_segment(times.data(), last, hint, time), expected(time));
+    }
+}
+
+}   // namespace
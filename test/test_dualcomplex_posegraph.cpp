@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_query.h>
+#include <dualcomplex/dualcomplex_posegraph.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexPoseGraphTest
+    : public ::testing::Test
+{
+protected:
+    static const T PI;
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-3f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-6; }
+
+    /**
+     * Ground truth poses along a closed loop.
+     */
+    static std::vector<dcn::DualComplex<T>> ground_truth()
+    {
+        std::vector<dcn::DualComplex<T>> res;
+        for(int i = 0; i < 8; i++)
+        {
+            const auto angle = PI * T(i) / T(4);
+            const auto d = std::polar(T(5), angle);
+            res.push_back(dcn::translation(d) * dcn::rotation(angle + PI / T(2)));
+        }
+        return res;
+    }
+
+    /**
+     * Builds a loop graph with exact measurements and a perturbed initial guess.
+     */
+    static dcn::PoseGraph<T> make_graph(const std::vector<dcn::DualComplex<T>>& truth)
+    {
+        dcn::PoseGraph<T> graph;
+        for(std::size_t i = 0; i < truth.size(); i++)
+        {
+            const auto noise = dcn::translation(std::complex<T>(T(0.1) * T(i % 3), T(-0.2) * T(i % 2)))
+                             * dcn::rotation(T(0.05) * T(i % 4));
+            graph.add_node((i == 0) ? truth[i] : truth[i] * noise, i == 0);
+        }
+        for(std::size_t i = 0; i < truth.size(); i++)
+        {
+            const auto j = (i + 1) % truth.size();
+            graph.add_edge(i, j, transformation_difference(truth[i], truth[j]));
+        }
+        graph.add_edge(0, 4, transformation_difference(truth[0], truth[4]));
+        return graph;
+    }
+};
+
+template<typename T>
+const T
+DualComplexPoseGraphTest<T>::PI = std::acos(-T(1));
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexPoseGraphTest, MyTypes);
+
+TYPED_TEST(DualComplexPoseGraphTest, residual)
+{
+    using Fixture = DualComplexPoseGraphTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto truth = Fixture::ground_truth();
+    dcn::PoseGraph<TypeParam> graph;
+    graph.add_node(truth[0]);
+    graph.add_node(truth[1]);
+    graph.add_edge(0, 1, transformation_difference(truth[0], truth[1]));
+    graph.add_edge(1, 0, -transformation_difference(truth[1], truth[0]));
+
+    EXPECT_TRUE(graph.residual(0).isZero(atol));
+    EXPECT_TRUE(graph.residual(1).isZero(atol));
+    EXPECT_ALMOST_EQUAL(TypeParam(0), graph.chi2(), atol);
+}
+
+TYPED_TEST(DualComplexPoseGraphTest, gauss_newton)
+{
+    using Fixture = DualComplexPoseGraphTest<TypeParam>;
+    using Graph = dcn::PoseGraph<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto truth = Fixture::ground_truth();
+    auto graph = Fixture::make_graph(truth);
+
+    typename Graph::Options options;
+    options.method = Graph::Method::GaussNewton;
+    const auto summary = graph.optimize(options);
+
+    EXPECT_TRUE(summary.converged);
+    EXPECT_LT(summary.final_chi2, summary.initial_chi2);
+    for(std::size_t i = 0; i < truth.size(); i++)
+    {
+        EXPECT_TRUE(is_unit(graph.pose(i), atol));
+        EXPECT_TRUE(are_same(truth[i], graph.pose(i), atol));
+    }
+}
+
+TYPED_TEST(DualComplexPoseGraphTest, gauss_newton_diverging_step)
+{
+    using Fixture = DualComplexPoseGraphTest<TypeParam>;
+    using Graph = dcn::PoseGraph<TypeParam>;
+    using T = TypeParam;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    // Conflicting measurements and a poor initial guess, where the first Gauss-Newton step increases chi2.
+    Graph graph;
+    const auto p1 = dcn::rotation(T(1));
+    const auto p2 = dcn::rotation(T(0));
+    graph.add_node(dcn::DualComplex<T>(T(1), T(0), T(0), T(0)), true);
+    graph.add_node(p1);
+    graph.add_node(p2);
+    graph.add_edge(0, 1, dcn::translation(std::complex<T>(T(1), T(0))));
+    graph.add_edge(1, 2, dcn::translation(std::complex<T>(T(1), T(0))));
+    graph.add_edge(0, 2, dcn::translation(std::complex<T>(T(0), T(2))) * dcn::rotation(T(3)));
+
+    typename Graph::Options options;
+    options.method = Graph::Method::GaussNewton;
+    const auto summary = graph.optimize(options);
+
+    EXPECT_FALSE(summary.converged);
+    EXPECT_EQ(summary.iterations, 1);
+    EXPECT_EQ(summary.final_chi2, summary.initial_chi2);
+    EXPECT_ALMOST_EQUAL(graph.chi2(), summary.initial_chi2, atol);
+    EXPECT_TRUE(are_same(p1, graph.pose(1), atol));
+    EXPECT_TRUE(are_same(p2, graph.pose(2), atol));
+}
+
+TYPED_TEST(DualComplexPoseGraphTest, levenberg_marquardt)
+{
+    using Fixture = DualComplexPoseGraphTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto truth = Fixture::ground_truth();
+    auto graph = Fixture::make_graph(truth);
+
+    const auto summary = graph.optimize();
+
+    EXPECT_TRUE(summary.converged);
+    EXPECT_ALMOST_EQUAL(TypeParam(0), summary.final_chi2, atol);
+    for(std::size_t i = 0; i < truth.size(); i++)
+    {
+        EXPECT_TRUE(are_same(truth[i], graph.pose(i), atol));
+    }
+}
+
+TYPED_TEST(DualComplexPoseGraphTest, relinearize_threshold)
+{
+    using Fixture = DualComplexPoseGraphTest<TypeParam>;
+    using Graph = dcn::PoseGraph<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto truth = Fixture::ground_truth();
+    auto graph = Fixture::make_graph(truth);
+
+    typename Graph::Options options;
+    options.relinearize_threshold = TypeParam(0.01);
+    options.max_iterations = 50;
+    const auto summary = graph.optimize(options);
+
+    EXPECT_TRUE(summary.converged);
+    for(std::size_t i = 0; i < truth.size(); i++)
+    {
+        EXPECT_TRUE(are_same(truth[i], graph.pose(i), atol));
+    }
+}
+
+TYPED_TEST(DualComplexPoseGraphTest, fixed)
+{
+    using Fixture = DualComplexPoseGraphTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto truth = Fixture::ground_truth();
+    auto graph = Fixture::make_graph(truth);
+    const auto initial = graph.pose(3);
+    graph.set_fixed(3, true);
+
+    graph.optimize();
+
+    EXPECT_TRUE(graph.is_fixed(3));
+    EXPECT_COMPLEX_ALMOST_EQUAL(initial.real(), graph.pose(3).real(), atol);
+    EXPECT_COMPLEX_ALMOST_EQUAL(initial.dual(), graph.pose(3).dual(), atol);
+    EXPECT_TRUE(are_same(truth[0], graph.pose(0), atol));
+}
+
+}   // namespace
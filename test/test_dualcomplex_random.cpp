@@ -0,0 +1,182 @@
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_jacobian.h>
+#include <dualcomplex/dualcomplex_random.h>
+#include "gtest_helper.h"
+#include "pose_helper.h"
+
+namespace
+{
+
+TEST(DualComplexRandomTest, philox4x32_10)
+{
+    // Known-answer vectors from the Random123 distribution.
+    struct Vector
+    {
+        std::uint32_t counter[4];
+        std::uint32_t key[2];
+        std::uint32_t expected[4];
+    };
+    const Vector vectors[] = {
+        { { 0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u }, { 0x00000000u, 0x00000000u },
+          { 0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u } },
+        { { 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu }, { 0xffffffffu, 0xffffffffu },
+          { 0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu } },
+        { { 0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u }, { 0xa4093822u, 0x299f31d0u },
+          { 0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u } },
+    };
+    for(const auto& v : vectors)
+    {
+        std::uint32_t out[4];
+        dcn::detail::philox4x32_10(v.counter, v.key, out);
+        for(int k = 0; k < 4; k++)
+            EXPECT_EQ(out[k], v.expected[k]);
+    }
+}
+
+template<typename T>
+class DualComplexRandomTypedTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    static void expect_identical(const dcn::DualComplexSoA<T>& lhs, const dcn::DualComplexSoA<T>& rhs)
+    {
+        ASSERT_EQ(lhs.size(), rhs.size());
+        for(std::size_t i = 0; i < lhs.size(); i++)
+        {
+            EXPECT_EQ(lhs.real_real()[i], rhs.real_real()[i]);
+            EXPECT_EQ(lhs.real_imag()[i], rhs.real_imag()[i]);
+            EXPECT_EQ(lhs.dual_real()[i], rhs.dual_real()[i]);
+            EXPECT_EQ(lhs.dual_imag()[i], rhs.dual_imag()[i]);
+        }
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexRandomTypedTest, MyTypes);
+
+TYPED_TEST(DualComplexRandomTypedTest, sample_poses_distribution)
+{
+    using T = TypeParam;
+    using vector_type = Eigen::Matrix<T, 3, 1>;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    const auto mean = pose_helper::make_pose(T(3), T(-1), T(0.8));
+    const vector_type sigma(T(0.1), T(0.2), T(0.05));
+    const std::size_t count = 40000;
+
+    dcn::DualComplexSoA<T> out(count);
+    dcn::sample_poses(mean, sigma, 42, 0, out);
+
+    vector_type sum = vector_type::Zero();
+    vector_type sum2 = vector_type::Zero();
+    for(std::size_t i = 0; i < count; i++)
+    {
+        EXPECT_NEAR(dcn::norm(out[i]), T(1), atol);
+        const vector_type tau = dcn::vee(dcn::log(dcn::transformation_difference(mean, out[i])));
+        sum += tau;
+        sum2 += tau.cwiseProduct(tau);
+    }
+    const auto n = static_cast<T>(count);
+    for(int k = 0; k < 3; k++)
+    {
+        const auto m = sum(k) / n;
+        const auto s = std::sqrt(sum2(k) / n - m * m);
+        EXPECT_NEAR(m, T(0), T(4) * sigma(k) / std::sqrt(n));
+        EXPECT_NEAR(s, sigma(k), T(0.03) * sigma(k));
+    }
+}
+
+TYPED_TEST(DualComplexRandomTypedTest, reproducible)
+{
+    using T = TypeParam;
+    using vector_type = Eigen::Matrix<T, 3, 1>;
+
+    const auto mean = pose_helper::make_pose(T(1), T(2), T(-0.5));
+    const vector_type sigma(T(0.5), T(0.5), T(0.1));
+    const std::size_t count = 1000;
+
+    dcn::DualComplexSoA<T> serial(count);
+    dcn::sample_poses(mean, sigma, 7, 3, serial);
+
+    // The same draws for any split into threads.
+    for(auto num_threads : { 2u, 3u, 0u })
+    {
+        dcn::DualComplexSoA<T> parallel(count);
+        dcn::sample_poses(mean, sigma, 7, 3, parallel, num_threads);
+        TestFixture::expect_identical(serial, parallel);
+    }
+
+    // A prefix of a larger batch.
+    dcn::DualComplexSoA<T> larger(count + 100);
+    dcn::sample_poses(mean, sigma, 7, 3, larger);
+    EXPECT_EQ(larger.real_real()[count - 1], serial.real_real()[count - 1]);
+    EXPECT_EQ(larger.dual_imag()[count - 1], serial.dual_imag()[count - 1]);
+
+    // Other streams and seeds give other draws.
+    dcn::DualComplexSoA<T> other_stream(count);
+    dcn::DualComplexSoA<T> other_seed(count);
+    dcn::sample_poses(mean, sigma, 7, 4, other_stream);
+    dcn::sample_poses(mean, sigma, 8, 3, other_seed);
+    std::size_t same_stream = 0, same_seed = 0;
+    for(std::size_t i = 0; i < count; i++)
+    {
+        if(other_stream.dual_real()[i] == serial.dual_real()[i])
+            same_stream++;
+        if(other_seed.dual_real()[i] == serial.dual_real()[i])
+            same_seed++;
+    }
+    EXPECT_EQ(same_stream, std::size_t(0));
+    EXPECT_EQ(same_seed, std::size_t(0));
+}
+
+TYPED_TEST(DualComplexRandomTypedTest, perturb_poses)
+{
+    using T = TypeParam;
+    using vector_type = Eigen::Matrix<T, 3, 1>;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    const vector_type sigma(T(0.3), T(0.1), T(0.2));
+    const std::size_t count = 700;
+
+    dcn::DualComplexSoA<T> particles;
+    for(std::size_t i = 0; i < count; i++)
+    {
+        const auto a = static_cast<T>(i) / static_cast<T>(count);
+        particles.push_back(pose_helper::make_pose(T(10) * a, T(-5) * a, T(6) * a - T(3)));
+    }
+
+    // Each particle moves by the same tangent draw as the sample around the identity.
+    dcn::DualComplexSoA<T> noise(count);
+    dcn::sample_poses(pose_helper::make_pose(T(0), T(0), T(0)), sigma, 99, 1, noise);
+
+    dcn::DualComplexSoA<T> out;
+    dcn::perturb_poses(particles, sigma, 99, 1, out, 2);
+    ASSERT_EQ(out.size(), count);
+    for(std::size_t i = 0; i < count; i++)
+    {
+        const vector_type expected = dcn::vee(dcn::log(noise[i]));
+        const vector_type actual = dcn::vee(dcn::log(dcn::transformation_difference(particles[i], out[i])));
+        for(int k = 0; k < 3; k++)
+            EXPECT_NEAR(actual(k), expected(k), T(10) * atol);
+    }
+
+    // In place.
+    dcn::perturb_poses(particles, sigma, 99, 1, particles);
+    TestFixture::expect_identical(particles, out);
+}
+
+}   // namespace
@@ -0,0 +1,201 @@
+#include <random>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_query.h>
+#include <dualcomplex/dualcomplex_ransac.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexRansacTest
+    : public ::testing::Test
+{
+protected:
+    static const T PI;
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-3f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-6; }
+
+    static dcn::DualComplex<T> truth()
+    {
+        return dcn::translation(std::complex<T>(T(2), T(-1))) * dcn::rotation(PI / T(5));
+    }
+
+    /**
+     * Exact correspondences where every index divisible by outlier_stride is replaced by an outlier.
+     */
+    static void make_correspondences(
+        std::size_t count,
+        std::size_t outlier_stride,
+        std::vector<std::complex<T>>& src,
+        std::vector<std::complex<T>>& dst)
+    {
+        std::mt19937 engine(7);
+        std::uniform_real_distribution<T> dist(T(-10), T(10));
+
+        src.clear();
+        dst.clear();
+        for(std::size_t i = 0; i < count; i++)
+        {
+            const auto x = dist(engine);
+            const auto s = std::complex<T>(x, dist(engine));
+            src.push_back(s);
+            dst.push_back(dcn::transform(truth(), s));
+            if(i % outlier_stride == 0)
+            {
+                const auto y = dist(engine);
+                dst.back() = std::complex<T>(y, dist(engine));
+            }
+        }
+    }
+};
+
+template<typename T>
+const T
+DualComplexRansacTest<T>::PI = std::acos(-T(1));
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexRansacTest, MyTypes);
+
+TYPED_TEST(DualComplexRansacTest, minimal_pose)
+{
+    using C = std::complex<TypeParam>;
+    using Fixture = DualComplexRansacTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    const auto p = Fixture::truth();
+    const auto s0 = C(TypeParam(1), TypeParam(2));
+    const auto s1 = C(TypeParam(-3), TypeParam(4));
+
+    const auto res = dcn::minimal_pose(s0, s1, dcn::transform(p, s0), dcn::transform(p, s1));
+
+    EXPECT_TRUE(are_same(p, res, atol));
+}
+
+TYPED_TEST(DualComplexRansacTest, score_hypotheses)
+{
+    using C = std::complex<TypeParam>;
+    using DC = dcn::DualComplex<TypeParam>;
+    using Fixture = DualComplexRansacTest<TypeParam>;
+
+    std::vector<C> src;
+    std::vector<C> dst;
+    Fixture::make_correspondences(50, 3, src, dst);
+
+    std::vector<DC> hypotheses;
+    for(int i = 0; i < 100; i++)
+    {
+        hypotheses.push_back(
+            dcn::translation(C(TypeParam(2) + TypeParam(0.01) * TypeParam(i), TypeParam(-1)))
+            * dcn::rotation(Fixture::PI / TypeParam(5) + TypeParam(0.001) * TypeParam(i % 7)));
+    }
+
+    const auto threshold = TypeParam(0.2);
+    std::vector<std::uint32_t> res(hypotheses.size());
+    dcn::score_hypotheses(hypotheses.data(), hypotheses.size(), src.data(), dst.data(), src.size(), threshold, res.data());
+
+    for(std::size_t h = 0; h < hypotheses.size(); h++)
+    {
+        std::uint32_t expected = 0;
+        for(std::size_t i = 0; i < src.size(); i++)
+        {
+            if(std::abs(dcn::transform(hypotheses[h], src[i]) - dst[i]) <= threshold)
+                expected++;
+        }
+        EXPECT_EQ(expected, res[h]);
+    }
+}
+
+TYPED_TEST(DualComplexRansacTest, uniform)
+{
+    using C = std::complex<TypeParam>;
+    using Estimator = dcn::RansacPoseEstimator<TypeParam>;
+    using Fixture = DualComplexRansacTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    std::vector<C> src;
+    std::vector<C> dst;
+    Fixture::make_correspondences(200, 3, src, dst);
+
+    const auto res = Estimator::estimate(src, dst);
+
+    EXPECT_TRUE(res.success);
+    EXPECT_TRUE(are_same(Fixture::truth(), res.transform, atol));
+    EXPECT_LT(res.hypotheses, typename Estimator::Options().max_hypotheses);
+    ASSERT_EQ(std::size_t(133), res.inliers.size());
+    for(auto i : res.inliers)
+    {
+        EXPECT_NE(std::size_t(0), i % 3);
+    }
+}
+
+TYPED_TEST(DualComplexRansacTest, progressive)
+{
+    using C = std::complex<TypeParam>;
+    using Estimator = dcn::RansacPoseEstimator<TypeParam>;
+    using Fixture = DualComplexRansacTest<TypeParam>;
+
+    constexpr auto atol = Fixture::absolute_tolerance();
+
+    std::vector<C> src;
+    std::vector<C> dst;
+    Fixture::make_correspondences(200, 2, src, dst);
+    // Sort by quality, inliers first.
+    std::vector<C> sorted_src;
+    std::vector<C> sorted_dst;
+    for(int pass = 0; pass < 2; pass++)
+    {
+        for(std::size_t i = 0; i < src.size(); i++)
+        {
+            if((i % 2 == 0) == (pass == 1))
+            {
+                sorted_src.push_back(src[i]);
+                sorted_dst.push_back(dst[i]);
+            }
+        }
+    }
+
+    typename Estimator::Options options;
+    options.sampling = Estimator::Sampling::Progressive;
+    options.batch_size = 1;
+    const auto res = Estimator::estimate(sorted_src, sorted_dst, options);
+
+    EXPECT_TRUE(res.success);
+    EXPECT_TRUE(are_same(Fixture::truth(), res.transform, atol));
+    EXPECT_EQ(std::size_t(100), res.inliers.size());
+}
+
+TYPED_TEST(DualComplexRansacTest, multithreaded)
+{
+    using C = std::complex<TypeParam>;
+    using Estimator = dcn::RansacPoseEstimator<TypeParam>;
+    using Fixture = DualComplexRansacTest<TypeParam>;
+
+    std::vector<C> src;
+    std::vector<C> dst;
+    Fixture::make_correspondences(300, 2, src, dst);
+
+    typename Estimator::Options options;
+    options.confidence = TypeParam(0.999);
+    const auto single = Estimator::estimate(src, dst, options);
+    options.num_threads = 4;
+    const auto multi = Estimator::estimate(src, dst, options);
+
+    EXPECT_TRUE(multi.success);
+    EXPECT_EQ(single.hypotheses, multi.hypotheses);
+    EXPECT_EQ(single.inliers, multi.inliers);
+    EXPECT_EQ(single.transform.real(), multi.transform.real());
+    EXPECT_EQ(single.transform.dual(), multi.transform.dual());
+}
+
+}   // namespace
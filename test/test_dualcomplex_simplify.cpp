@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <vector>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_interpolation.h>
+#include <dualcomplex/dualcomplex_simplify.h>
+#include "gtest_helper.h"
+#include "pose_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexSimplifyTest
+    : public ::testing::Test
+{
+protected:
+    /**
+     * A vehicle weaving along a road, one pose per tick.
+     */
+    static std::vector<dcn::DualComplex<T>> make_trajectory(std::size_t count)
+    {
+        std::vector<dcn::DualComplex<T>> res;
+        for(std::size_t i = 0; i < count; i++)
+        {
+            const auto t = T(0.01) * static_cast<T>(i);
+            res.push_back(pose_helper::make_pose(T(2) * t, std::sin(t), std::atan2(std::cos(t), T(2))));
+        }
+        return res;
+    }
+
+    /**
+     * Checks that every pose is reconstructed from the keys within the tolerances.
+     */
+    static void expect_within_tolerance(
+        const std::vector<dcn::DualComplex<T>>& poses,
+        const T* times,
+        const std::vector<std::size_t>& keys,
+        const dcn::SimplifyOptions<T>& options)
+    {
+        ASSERT_GE(keys.size(), std::size_t(2));
+        EXPECT_EQ(keys.front(), std::size_t(0));
+        EXPECT_EQ(keys.back(), poses.size() - 1);
+        EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+
+        const auto slack = T(1) + T(10) * std::numeric_limits<T>::epsilon() / options.translation_tolerance;
+        for(std::size_t k = 0; k + 1 < keys.size(); k++)
+        {
+            const auto a = keys[k];
+            const auto b = keys[k + 1];
+            ASSERT_LT(a, b);
+            const auto ta = times ? times[a] : static_cast<T>(a);
+            const auto tb = times ? times[b] : static_cast<T>(b);
+            for(auto i = a + 1; i < b; i++)
+            {
+                const auto s = ((times ? times[i] : static_cast<T>(i)) - ta) / (tb - ta);
+                const auto approx = dcn::slerp_shortestpath(poses[a], poses[b], s);
+                const auto origin = std::complex<T>(0, 0);
+                const auto heading = std::complex<T>(1, 0);
+                const auto translation = dcn::transform(poses[i], origin) - dcn::transform(approx, origin);
+                const auto rotation = (dcn::transform(poses[i], heading) - dcn::transform(poses[i], origin))
+                                    / (dcn::transform(approx, heading) - dcn::transform(approx, origin));
+                EXPECT_LE(std::abs(translation), options.translation_tolerance * slack);
+                EXPECT_LE(std::abs(std::arg(rotation)), options.angle_tolerance * slack);
+            }
+        }
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexSimplifyTest, MyTypes);
+
+TYPED_TEST(DualComplexSimplifyTest, small)
+{
+    using T = TypeParam;
+
+    const auto pose = pose_helper::make_pose(T(1), T(2), T(0.3));
+    EXPECT_TRUE(dcn::simplify_trajectory<T>(nullptr, nullptr, 0).empty());
+    EXPECT_EQ(dcn::simplify_trajectory<T>(&pose, nullptr, 1), std::vector<std::size_t>({ 0 }));
+}
+
+TYPED_TEST(DualComplexSimplifyTest, uniform_motion)
+{
+    using T = TypeParam;
+
+    // Constant velocity and turn rate are reproduced exactly by slerp.
+    std::vector<dcn::DualComplex<T>> poses;
+    for(std::size_t i = 0; i < 500; i++)
+    {
+        const auto t = static_cast<T>(i) / T(499);
+        poses.push_back(dcn::slerp(pose_helper::make_pose(T(0), T(0), T(0)), pose_helper::make_pose(T(5), T(-2), T(1)), t));
+    }
+    const auto keys = dcn::simplify_trajectory<T>(poses.data(), nullptr, poses.size());
+    EXPECT_EQ(keys, std::vector<std::size_t>({ 0, poses.size() - 1 }));
+}
+
+TYPED_TEST(DualComplexSimplifyTest, bounded_error)
+{
+    using T = TypeParam;
+
+    const auto poses = TestFixture::make_trajectory(2000);
+    for(auto tolerance : { T(1e-2), T(1e-3) })
+    {
+        dcn::SimplifyOptions<T> options;
+        options.translation_tolerance = tolerance;
+        options.angle_tolerance = tolerance;
+        const auto keys = dcn::simplify_trajectory<T>(poses.data(), nullptr, poses.size(), options);
+        EXPECT_LT(keys.size() * 5, poses.size());
+        TestFixture::expect_within_tolerance(poses, nullptr, keys, options);
+    }
+}
+
+TYPED_TEST(DualComplexSimplifyTest, timestamps)
+{
+    using T = TypeParam;
+
+    // Irregular ticks, with the poses of the same motion at those times.
+    std::vector<T> times;
+    std::vector<dcn::DualComplex<T>> poses;
+    auto time = T(0);
+    for(std::size_t i = 0; i < 1000; i++)
+    {
+        times.push_back(time);
+        poses.push_back(pose_helper::make_pose(T(2) * time, std::sin(time), std::atan2(std::cos(time), T(2))));
+        time += (i % 3 == 0) ? T(0.03) : T(0.005);
+    }
+
+    dcn::SimplifyOptions<T> options;
+    options.translation_tolerance = T(5e-3);
+    options.angle_tolerance = T(1e-2);
+    const auto keys = dcn::simplify_trajectory(poses.data(), times.data(), poses.size(), options);
+    EXPECT_LT(keys.size() * 10, poses.size());
+    TestFixture::expect_within_tolerance(poses, times.data(), keys, options);
+}
+
+TYPED_TEST(DualComplexSimplifyTest, chunks)
+{
+    using T = TypeParam;
+
+    const auto poses = TestFixture::make_trajectory(3000);
+    dcn::SimplifyOptions<T> options;
+    options.chunk_size = 256;
+    const auto keys = dcn::simplify_trajectory<T>(poses.data(), nullptr, poses.size(), options);
+    TestFixture::expect_within_tolerance(poses, nullptr, keys, options);
+    for(std::size_t i = 0; i < poses.size(); i += options.chunk_size)
+        EXPECT_TRUE(std::binary_search(keys.begin(), keys.end(), i));
+
+    for(auto num_threads : { 2u, 4u, 0u })
+    {
+        options.num_threads = num_threads;
+        EXPECT_EQ(dcn::simplify_trajectory<T>(poses.data(), nullptr, poses.size(), options), keys);
+    }
+}
+
+}   // namespace
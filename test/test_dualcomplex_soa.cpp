@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_soa.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexSoATest
+    : public ::testing::Test
+{
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexSoATest, MyTypes);
+
+TYPED_TEST(DualComplexSoATest, constructor)
+{
+    using DC = dcn::DualComplex<TypeParam>;
+    using SoA = dcn::DualComplexSoA<TypeParam>;
+
+    {
+        const SoA soa;
+        EXPECT_TRUE(soa.empty());
+        EXPECT_EQ(std::size_t(0), soa.size());
+    }
+    {
+        const std::vector<DC> dcs = {
+            DC(TypeParam(1), TypeParam(2), TypeParam(3), TypeParam(4)),
+            DC(TypeParam(5), TypeParam(6), TypeParam(7), TypeParam(8))
+        };
+        const SoA soa(dcs);
+        ASSERT_EQ(dcs.size(), soa.size());
+        for(std::size_t i = 0; i < dcs.size(); i++)
+        {
+            EXPECT_EQ(dcs[i].real(), soa[i].real());
+            EXPECT_EQ(dcs[i].dual(), soa[i].dual());
+            EXPECT_EQ(dcs[i].real().real(), soa.real_real()[i]);
+            EXPECT_EQ(dcs[i].real().imag(), soa.real_imag()[i]);
+            EXPECT_EQ(dcs[i].dual().real(), soa.dual_real()[i]);
+            EXPECT_EQ(dcs[i].dual().imag(), soa.dual_imag()[i]);
+        }
+    }
+}
+
+TYPED_TEST(DualComplexSoATest, modifiers)
+{
+    using DC = dcn::DualComplex<TypeParam>;
+    using SoA = dcn::DualComplexSoA<TypeParam>;
+
+    const auto dc0 = DC(TypeParam(1), TypeParam(2), TypeParam(3), TypeParam(4));
+    const auto dc1 = DC(TypeParam(5), TypeParam(6), TypeParam(7), TypeParam(8));
+
+    SoA soa;
+    soa.push_back(dc0);
+    soa.push_back(dc1);
+    ASSERT_EQ(std::size_t(2), soa.size());
+    EXPECT_EQ(dc0.real(), soa.get(0).real());
+    EXPECT_EQ(dc0.dual(), soa.get(0).dual());
+    EXPECT_EQ(dc1.real(), soa.get(1).real());
+    EXPECT_EQ(dc1.dual(), soa.get(1).dual());
+
+    soa.set(0, dc1);
+    EXPECT_EQ(dc1.real(), soa.get(0).real());
+    EXPECT_EQ(dc1.dual(), soa.get(0).dual());
+
+    soa.resize(3);
+    EXPECT_EQ(std::size_t(3), soa.size());
+    EXPECT_EQ(DC().real(), soa.get(2).real());
+    EXPECT_EQ(DC().dual(), soa.get(2).dual());
+
+    soa.clear();
+    EXPECT_TRUE(soa.empty());
+}
+
+}   // namespace
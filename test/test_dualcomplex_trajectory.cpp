@@ -0,0 +1,161 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include <dualcomplex/dualcomplex_base.h>
+#include <dualcomplex/dualcomplex_transform.h>
+#include <dualcomplex/dualcomplex_trajectory.h>
+#include "gtest_helper.h"
+#include "pose_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DualComplexTrajectoryTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-9; }
+
+    static const T PI;
+};
+
+template<typename T>
+const T
+DualComplexTrajectoryTest<T>::PI = std::acos(-T(1));
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DualComplexTrajectoryTest, MyTypes);
+
+TYPED_TEST(DualComplexTrajectoryTest, screw_root)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    const dcn::DualComplex<T> motions[] = {
+        pose_helper::make_pose(T(3), T(-2), T(0.7)),
+        pose_helper::make_pose(T(-1), T(4), T(-2.5)),
+        pose_helper::make_pose(T(2), T(1), T(0)),
+        pose_helper::make_pose(T(0.5), T(0.5), T(0.97) * TestFixture::PI),
+        -pose_helper::make_pose(T(1), T(-3), T(1.2)),
+    };
+    for(const auto& motion : motions)
+    {
+        for(auto steps : { std::size_t(1), std::size_t(2), std::size_t(7), std::size_t(64) })
+        {
+            const auto step = dcn::screw_root(motion, steps);
+            EXPECT_NEAR(dcn::norm(step), T(1), atol);
+
+            auto power = dcn::DualComplex<T>(T(1), T(0), T(0), T(0));
+            for(std::size_t k = 0; k < steps; k++)
+                power *= step;
+            pose_helper::expect_same_motion(power, motion, T(10) * atol);
+        }
+    }
+}
+
+TYPED_TEST(DualComplexTrajectoryTest, screw_root_fixes_center)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    // A quarter turn about (2, 1), whose steps all turn about the same point.
+    const auto center = std::complex<T>(2, 1);
+    const auto motion = dcn::translation(center) * dcn::rotation(TestFixture::PI / T(2)) * dcn::translation(-center);
+    const auto step = dcn::screw_root(motion, 5);
+    EXPECT_COMPLEX_ALMOST_EQUAL(dcn::transform(step, center), center, atol);
+    EXPECT_NEAR(std::arg(step.real() * step.real()), TestFixture::PI / T(10), atol);
+}
+
+TYPED_TEST(DualComplexTrajectoryTest, sample_screw)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    const auto dc0 = pose_helper::make_pose(T(1), T(2), T(0.3));
+    const auto dc1 = pose_helper::make_pose(T(-4), T(5), T(2.9));
+    const std::size_t steps = 100;
+
+    std::vector<dcn::DualComplex<T>> out(steps + 1);
+    dcn::sample_screw(dc0, dc1, steps, out.data(), 8);
+
+    pose_helper::expect_same_motion(out.front(), dc0, atol);
+    pose_helper::expect_same_motion(out.back(), dc1, T(10) * atol);
+
+    // Every sample is dc0 * step^k and stays unit.
+    const auto step = dcn::screw_root(dcn::transformation_difference(dc0, dc1), steps);
+    auto expected = dc0;
+    for(std::size_t k = 0; k <= steps; k++)
+    {
+        EXPECT_NEAR(dcn::norm(out[k]), T(1), T(10) * atol);
+        pose_helper::expect_same_motion(out[k], expected, T(10) * atol);
+        expected = dcn::normalize(expected * step);
+    }
+
+    // Consecutive samples are evenly spaced.
+    for(std::size_t k = 0; k < steps; k++)
+        pose_helper::expect_same_motion(dcn::transformation_difference(out[k], out[k + 1]), step, T(10) * atol);
+}
+
+TYPED_TEST(DualComplexTrajectoryTest, sample_screw_translation)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    const auto dc0 = pose_helper::make_pose(T(1), T(1), T(0.5));
+    const auto dc1 = pose_helper::make_pose(T(9), T(-3), T(0.5));
+    const std::size_t steps = 4;
+
+    std::vector<dcn::DualComplex<T>> out(steps + 1);
+    dcn::sample_screw(dc0, dc1, steps, out.data());
+    for(std::size_t k = 0; k <= steps; k++)
+    {
+        const auto a = static_cast<T>(k) / static_cast<T>(steps);
+        pose_helper::expect_same_motion(out[k], pose_helper::make_pose(T(1) + T(8) * a, T(1) - T(4) * a, T(0.5)), atol);
+    }
+}
+
+TYPED_TEST(DualComplexTrajectoryTest, sample_screw_shortest_path)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    // From 0.9 pi to -0.9 pi the short way is through pi.
+    const auto dc0 = pose_helper::make_pose(T(0), T(0), T(0.9) * TestFixture::PI);
+    const auto dc1 = pose_helper::make_pose(T(0), T(0), T(-0.9) * TestFixture::PI);
+    const std::size_t steps = 2;
+
+    std::vector<dcn::DualComplex<T>> out(steps + 1);
+    dcn::sample_screw(dc0, dc1, steps, out.data());
+    pose_helper::expect_same_motion(out[1], pose_helper::make_pose(T(0), T(0), TestFixture::PI), atol);
+    pose_helper::expect_same_motion(out[2], dc1, atol);
+}
+
+TYPED_TEST(DualComplexTrajectoryTest, transform_footprint)
+{
+    using T = TypeParam;
+    const auto atol = TestFixture::absolute_tolerance();
+
+    const std::vector<std::complex<T>> footprint = {
+        std::complex<T>(-1, -0.5), std::complex<T>(1, -0.5), std::complex<T>(1, 0.5), std::complex<T>(-1, 0.5),
+        std::complex<T>(1.5, 0)
+    };
+    const std::size_t steps = 16;
+    std::vector<dcn::DualComplex<T>> poses(steps + 1);
+    dcn::sample_screw(pose_helper::make_pose(T(0), T(0), T(0)), pose_helper::make_pose(T(6), T(2), T(1.5)), steps, poses.data());
+
+    std::vector<std::complex<T>> out(poses.size() * footprint.size());
+    dcn::transform_footprint(poses.data(), poses.size(), footprint.data(), footprint.size(), out.data());
+    for(std::size_t i = 0; i < poses.size(); i++)
+    {
+        for(std::size_t j = 0; j < footprint.size(); j++)
+            EXPECT_COMPLEX_ALMOST_EQUAL(out[i * footprint.size() + j], dcn::transform(poses[i], footprint[j]), atol);
+    }
+}
+
+}   // namespace
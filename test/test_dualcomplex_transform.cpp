@@ -99,6 +99,29 @@ TYPED_TEST(DualComplexTransformTest, transform)
     }
 }
 
+TYPED_TEST(DualComplexTransformTest, transform_bulk)
+{
+    using C = std::complex<TypeParam>;
+
+    constexpr auto atol = DualComplexTransformTest<TypeParam>::absolute_tolerance();
+
+    const auto angle = DualComplexTransformTest<TypeParam>::PI / TypeParam(3);
+    const auto d = C(TypeParam(1), TypeParam(2));
+    const auto p = dcn::translation(d) * dcn::rotation(angle);
+
+    std::vector<C> v;
+    for(int i = 0; i < 17; i++)
+        v.push_back(C(TypeParam(i), TypeParam(3 - i)));
+
+    std::vector<C> res(v.size());
+    dcn::transform(p, v.data(), v.size(), res.data());
+
+    for(std::size_t i = 0; i < v.size(); i++)
+    {
+        EXPECT_COMPLEX_ALMOST_EQUAL(dcn::transform(p, v[i]), res[i], atol);
+    }
+}
+
 TYPED_TEST(DualComplexTransformTest, transformation_difference)
 {
     using C = std::complex<TypeParam>;